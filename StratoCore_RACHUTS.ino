@@ -19,7 +19,9 @@ uint8_t Zephyr_serial_RX_buffer[ZEPHYR_SERIAL_BUFFER_SIZE];
 uint8_t mcb_serial_TX_buffer[MCB_SERIAL_BUFFER_SIZE];
 uint8_t mcb_serial_RX_buffer[MCB_SERIAL_BUFFER_SIZE];
 uint8_t pu_serial_TX_buffer[PU_SERIAL_BUFFER_SIZE];
+#ifndef PU_SERIAL_DMA
 uint8_t pu_serial_RX_buffer[PU_SERIAL_BUFFER_SIZE];
+#endif
 
 // timer control variables
 volatile uint8_t timer_counter = 0;
@@ -46,7 +48,7 @@ void setup()
   Serial.begin(115200);
   ZEPHYR_SERIAL.begin(115200);
   MCB_SERIAL.begin(115200);
-  PU_SERIAL.begin(115200);
+  PU_SERIAL.begin(LINK_BASE_BAUD);
 
   delay(2000); // allow time to connect a serial monitor
   Serial.println(String("StratoCore_RACHUTS ") + RACHUTS_VERSION + " Build: " + __DATE__ + " " + __TIME__);
@@ -56,7 +58,9 @@ void setup()
   ZEPHYR_SERIAL.addMemoryForWrite(&Zephyr_serial_TX_buffer, sizeof(Zephyr_serial_TX_buffer));
   MCB_SERIAL.addMemoryForRead(&mcb_serial_RX_buffer, sizeof(mcb_serial_RX_buffer));
   MCB_SERIAL.addMemoryForWrite(&mcb_serial_TX_buffer, sizeof(mcb_serial_TX_buffer));
+#ifndef PU_SERIAL_DMA // pib.InstrumentSetup() hands PU_SERIAL's receive to eDMA instead
   PU_SERIAL.addMemoryForRead(&pu_serial_RX_buffer, sizeof(pu_serial_RX_buffer));
+#endif
   PU_SERIAL.addMemoryForWrite(&pu_serial_TX_buffer, sizeof(pu_serial_TX_buffer));
 
 
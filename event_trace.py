@@ -0,0 +1,127 @@
+"""RACHUTS event trace renderer.
+
+Reads the event and state machine names from src/EventTrace.h,
+src/PhaseTimeline.h and src/StratoRachuts.h.
+
+    python3 event_trace.py tm trace.bin      a RACHUTSTRACE TM payload (binary)
+    python3 event_trace.py dump < log.txt    a 'T' dump from the USB debug port
+
+One event per line: its number, its time, and what it was. Times are
+millis() rebuilt from the TRACE_MARK events and the cycle counter (--mhz,
+default 600, the Teensy 4.1 clock); events before the first mark have
+none. A TM also carries the epoch it was sent at, which dates each event.
+"""
+import os
+import re
+import struct
+import sys
+import time
+
+src_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "src")
+
+RECORD = struct.Struct("<IBBH")     # TraceRecord_t
+TM_HEADER = struct.Struct("<IIIIH") # epoch, millis, cycles, first, count
+MARK_MASK = 0xFFFFFF                # a mark carries the low 24 bits of millis()
+
+
+def read_enum(header, name):
+    with open(os.path.join(src_dir, header)) as f:
+        body = re.search(r"enum\s+%s\s*:\s*\w+\s*\{(.*?)\};" % name, f.read(), re.S).group(1)
+    body = re.sub(r"//[^\n]*", "", body)
+    return [entry.strip() for entry in body.split(",") if entry.strip()]
+
+
+def name(names, index, prefix):
+    return names[index][len(prefix):] if index < len(names) and names[index].startswith(prefix) else str(index)
+
+
+def describe(event, id, value, names):
+    kind = name(names["event"], event, "TRACE_")
+    if kind == "MARK":
+        return "MARK"
+    if kind == "SUBSTATE":
+        return "SUBSTATE %u" % value
+    if kind == "STATE":
+        return "STATE %s %u" % (name(names["machine"], id, "TL_"), value)
+    if kind in ("ACTION_SET", "ACTION_FIRE"):
+        return "%s action %u" % (kind, id)
+    if kind in ("MCB_RX", "PU_RX"):
+        return "%s type %u id %u" % (kind, id, value)
+    if kind == "LORA_RX":
+        return "LORA_RX length %u first 0x%04X" % (id, value)
+    if kind == "TM":
+        return "TM %s" % name(names["tm"], id, "ZEPHYRTX_")
+    if kind == "TC":
+        return "TC %u" % value
+    return "%s id %u value %u" % (kind, id, value)
+
+
+def render(first, records, names, cycles_per_ms, anchor=None):
+    """anchor: (epoch, millis, cycles) when the records were sent"""
+    mark_ms = None
+    mark_cycles = 0
+    for offset, (cycles, event, id, value) in enumerate(records):
+        if name(names["event"], event, "TRACE_") == "MARK":
+            mark_ms = (id << 16) | value
+            mark_cycles = cycles
+            if anchor is not None:
+                # the full millis() is the latest at or before sending with these low bits
+                mark_ms = anchor[1] - ((anchor[1] - mark_ms) & MARK_MASK)
+
+        stamp = "%12s" % "?"
+        if mark_ms is not None:
+            ms = mark_ms + ((cycles - mark_cycles) & 0xFFFFFFFF) / cycles_per_ms
+            stamp = "%12.3f" % ms
+            if anchor is not None and anchor[0]:
+                when = anchor[0] + (ms - anchor[1]) / 1000.0
+                stamp += time.strftime(" %Y-%m-%dT%H:%M:%S", time.gmtime(when)) + ("%.3fZ" % (when % 1))[1:]
+
+        print("%8u %s  %s" % (first + offset, stamp, describe(event, id, value, names)))
+
+
+def tm(path, names, cycles_per_ms):
+    with open(path, "rb") as f:
+        data = f.read()
+    epoch, millis, cycles, first, count = TM_HEADER.unpack_from(data)
+    if len(data) < TM_HEADER.size + count * RECORD.size:
+        sys.exit("truncated TM: %u events declared, %u bytes" % (count, len(data)))
+
+    print("sent at epoch %u, millis %u, events %u from %u" % (epoch, millis, count, first))
+    records = [RECORD.unpack_from(data, TM_HEADER.size + i * RECORD.size) for i in range(count)]
+    render(first, records, names, cycles_per_ms, (epoch, millis, cycles))
+
+
+def dump(names, cycles_per_ms):
+    records = None
+    for line in sys.stdin:
+        line = line.strip()
+        if re.search(r"TRACE \d+$", line):
+            records = []
+        elif line.endswith("TRACE END") and records is not None:
+            # the ring held the last len(records) events; only their order is known
+            render(0, records, names, cycles_per_ms)
+            records = None
+        elif records is not None and re.fullmatch(r"[0-9A-Fa-f]{%u}" % (2 * RECORD.size), line):
+            records.append(RECORD.unpack(bytes.fromhex(line)))
+
+
+if __name__ == "__main__":
+    args = sys.argv[1:]
+    mhz = 600.0
+    if len(args) >= 2 and args[0] == "--mhz":
+        mhz = float(args[1])
+        args = args[2:]
+
+    if not args or args[0] not in ("tm", "dump") or (args[0] == "tm") != (len(args) == 2):
+        print(__doc__)
+        sys.exit(1)
+
+    names = {
+        "event": read_enum("EventTrace.h", "TraceEvent_t"),
+        "machine": read_enum("PhaseTimeline.h", "TimelineMachine_t"),
+        "tm": read_enum("StratoRachuts.h", "ZephyrTXMsgType_t"),
+    }
+    if args[0] == "tm":
+        tm(args[1], names, mhz * 1000.0)
+    else:
+        dump(names, mhz * 1000.0)
@@ -0,0 +1,141 @@
+/*
+ *  BatchSizer.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the adaptive record-batch sizing for PU offloads.
+ */
+
+#include "BatchSizer.h"
+
+static uint16_t Saturate16(uint32_t value)
+{
+    return (value > UINT16_MAX) ? UINT16_MAX : (uint16_t) value;
+}
+
+void BatchSizer::StartOffload(uint16_t record_budget, bool adaptive_batch, uint32_t now_ms)
+{
+    adaptive = adaptive_batch;
+    budget = (record_budget < BATCH_MIN_RECORDS) ? BATCH_MIN_RECORDS : record_budget;
+    batch = (BATCH_START_RECORDS > budget) ? budget : BATCH_START_RECORDS;
+    num_blocks = 0;
+    total_blocks = 0;
+    total_records = 0;
+    lost_blocks = 0;
+    fail_pm = 0;
+    ack_avg_ms = 0;
+    start_ms = now_ms;
+}
+
+void BatchSizer::BeginBlock(uint32_t now_ms)
+{
+    block_start_ms = now_ms;
+    current.requested = batch;
+    current.received = 0;
+    current.ack_ms = 0;
+    current.rx_ms = 0;
+    current.outcome = BATCH_CLEAN;
+}
+
+void BatchSizer::NoteCorrupt()
+{
+    current.outcome |= BATCH_CORRUPT;
+}
+
+void BatchSizer::NoteRetry()
+{
+    current.outcome |= BATCH_RETRY;
+}
+
+void BatchSizer::Received(uint16_t records, uint32_t now_ms)
+{
+    current.received = records;
+    current.rx_ms = Saturate16(now_ms - block_start_ms);
+}
+
+void BatchSizer::EndBlock(uint32_t ack_ms, bool tm_acked)
+{
+    if (!tm_acked) current.outcome |= BATCH_TM_RESEND;
+    current.ack_ms = Saturate16(ack_ms);
+
+    Finish();
+
+    // a TM resend says nothing about the dock link, only the latency counts
+    Adapt(0 != (current.outcome & (BATCH_CORRUPT | BATCH_RETRY)), ack_ms);
+}
+
+void BatchSizer::LostBlock()
+{
+    current.outcome |= BATCH_LOST;
+
+    Finish();
+
+    Adapt(true, ack_avg_ms);
+}
+
+void BatchSizer::Finish()
+{
+    if (num_blocks < BATCH_LOG_SIZE) blocks[num_blocks++] = current;
+
+    if (total_blocks < UINT16_MAX) total_blocks++;
+    total_records += current.received;
+    if ((current.outcome & BATCH_LOST) && lost_blocks < UINT16_MAX) lost_blocks++;
+}
+
+void BatchSizer::Adapt(bool failed, uint32_t ack_ms)
+{
+    // weight 1/4 on the newest block
+    fail_pm = fail_pm - fail_pm / 4 + (failed ? 250 : 0);
+    ack_avg_ms = (0 == ack_avg_ms) ? ack_ms : ack_avg_ms - ack_avg_ms / 4 + ack_ms / 4;
+
+    if (!adaptive) return;
+
+    if (failed) {
+        batch /= 2;
+    } else if (ack_avg_ms > BATCH_ACK_SLOW_MS) {
+        batch = (batch > BATCH_STEP) ? batch - BATCH_STEP : 0;
+    } else if (fail_pm < BATCH_FAIL_GROW_PM && ack_avg_ms < BATCH_ACK_FAST_MS) {
+        batch += BATCH_STEP;
+    }
+
+    if (batch < BATCH_MIN_RECORDS) batch = BATCH_MIN_RECORDS;
+    if (batch > budget) batch = budget;
+}
+
+uint16_t BatchSizer::RxPercentile(uint8_t percent)
+{
+    return Percentile(true, percent);
+}
+
+uint16_t BatchSizer::AckPercentile(uint8_t percent)
+{
+    return Percentile(false, percent);
+}
+
+// nearest-rank over the logged blocks that completed; lost blocks have no
+// timings and are counted separately
+uint16_t BatchSizer::Percentile(bool rx, uint8_t percent)
+{
+    uint16_t values[BATCH_LOG_SIZE];
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < num_blocks; i++) {
+        if (blocks[i].outcome & BATCH_LOST) continue;
+
+        // insertion sort, at most BATCH_LOG_SIZE entries once per offload
+        uint16_t value = rx ? blocks[i].rx_ms : blocks[i].ack_ms;
+        uint8_t j = count++;
+        while (j > 0 && values[j - 1] > value) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+
+    if (0 == count) return 0;
+    if (percent > 100) percent = 100;
+
+    // the smallest value with at least percent of the values at or below it:
+    // rank ceil(percent * count / 100), counting from 1
+    uint16_t rank = ((uint16_t) count * percent + 99) / 100;
+    return values[(rank > 0) ? rank - 1 : 0];
+}
@@ -0,0 +1,112 @@
+/*
+ *  BatchSizer.h
+ *  Created: October 2026
+ *
+ *  Chooses how many records to request in each RPU_SEND_RECORDS during a
+ *  profile offload, from the measured quality of the dock link and the
+ *  Zephyr TM ack latency:
+ *    - a block that arrived corrupt or needed a resend halves the batch, so
+ *      each retry on a noisy link costs less
+ *    - a run of clean blocks with prompt TM acks grows it by BATCH_STEP up to
+ *      the record budget, amortising the per-block overhead on a clean link
+ *    - slow TM acks (Zephyr backlog) shrink it by BATCH_STEP
+ *
+ *  Each of the first BATCH_LOG_SIZE blocks' requested size, received size,
+ *  outcome and timings is kept for the per-offload summary TM and its latency
+ *  percentiles. The offload's block, record and lost-block totals and its
+ *  duration cover every block, however long the offload, so its throughput
+ *  can be compared between offloads.
+ */
+
+#ifndef BATCHSIZER_H
+#define BATCHSIZER_H
+
+#include "Arduino.h"
+
+#define BATCH_MIN_RECORDS   20      // never request fewer than this
+#define BATCH_START_RECORDS 160     // first request of an offload (historical fixed size)
+#define BATCH_STEP          16      // additive growth/shrink step
+#define BATCH_ACK_FAST_MS   5000    // average TM ack latency below which growth is allowed
+#define BATCH_ACK_SLOW_MS   20000   // average TM ack latency above which the batch shrinks
+#define BATCH_FAIL_GROW_PM  100     // failure rate (per mille) below which growth is allowed
+#define BATCH_LOG_SIZE      64      // blocks recorded per offload
+
+// block outcome flags, combined per block
+enum BatchOutcome_t : uint8_t {
+    BATCH_CLEAN     = 0x00, // received intact, TM acked
+    BATCH_CORRUPT   = 0x01, // received with a bad checksum or uncorrectable FEC
+    BATCH_RETRY     = 0x02, // needed a resend request from the PIB
+    BATCH_TM_RESEND = 0x04, // TM was NAKed or timed out and resent
+    BATCH_LOST      = 0x08, // never received
+};
+
+struct BatchBlock_t {
+    uint16_t requested;
+    uint16_t received;
+    uint16_t ack_ms;        // TM ack latency, saturating
+    uint16_t rx_ms;         // request to receipt, including resends, saturating
+    uint8_t outcome;        // BatchOutcome_t flags
+};
+
+class BatchSizer {
+public:
+    BatchSizer() { };
+    ~BatchSizer() { };
+
+    // Start a new offload with the given record budget (largest batch that
+    // fits). When not adaptive the batch stays fixed and is only logged.
+    void StartOffload(uint16_t budget, bool adaptive, uint32_t now_ms);
+
+    // Size to request for the next block
+    uint16_t Next() { return batch; }
+
+    // Block lifecycle, in order: Begin, any Note*, Received, End
+    void BeginBlock(uint32_t now_ms);
+    void NoteCorrupt();
+    void NoteRetry();
+    void Received(uint16_t records, uint32_t now_ms);
+    void EndBlock(uint32_t ack_ms, bool tm_acked);
+    void LostBlock();
+
+    // Offload summary: the logged blocks
+    uint8_t Blocks() { return num_blocks; }
+    const BatchBlock_t & Block(uint8_t index) { return blocks[index]; }
+    uint16_t FailurePerMille() { return fail_pm; }
+    uint32_t AverageAckMs() { return ack_avg_ms; }
+
+    // Offload totals over every block, logged or not
+    uint32_t DurationMs(uint32_t now_ms) { return now_ms - start_ms; }
+    uint16_t TotalBlocks() { return total_blocks; }
+    uint32_t Records() { return total_records; }
+    uint16_t LostBlocks() { return lost_blocks; }
+
+    // Percentile (0-100) of the logged blocks' receipt or TM ack latency
+    uint16_t RxPercentile(uint8_t percent);
+    uint16_t AckPercentile(uint8_t percent);
+
+private:
+    // Log the current block and add it to the offload totals
+    void Finish();
+
+    // Fold the current block into the running averages and pick the next size
+    void Adapt(bool failed, uint32_t ack_ms);
+
+    uint16_t Percentile(bool rx, uint8_t percent);
+
+    BatchBlock_t blocks[BATCH_LOG_SIZE] = {};
+    BatchBlock_t current = {};
+    uint8_t num_blocks = 0;
+    uint16_t total_blocks = 0;
+    uint32_t total_records = 0;
+    uint16_t lost_blocks = 0;
+
+    bool adaptive = false;
+    uint16_t budget = BATCH_START_RECORDS;
+    uint16_t batch = BATCH_START_RECORDS;
+    uint16_t fail_pm = 0;           // exponentially-weighted failure rate, per mille
+    uint32_t ack_avg_ms = 0;        // exponentially-weighted TM ack latency
+    uint32_t start_ms = 0;          // millis() at StartOffload
+    uint32_t block_start_ms = 0;    // millis() at BeginBlock
+};
+
+#endif /* BATCHSIZER_H */
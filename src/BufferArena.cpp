@@ -0,0 +1,44 @@
+/*
+ *  BufferArena.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the phase-scoped buffer pool.
+ */
+
+#include "BufferArena.h"
+
+BufferArena::BufferArena(uint8_t * pool, const ArenaLease_t * table, uint8_t count)
+    : pool(pool)
+    , table(table)
+    , count((count > ARENA_MAX_LEASES) ? ARENA_MAX_LEASES : count)
+{
+    for (uint8_t i = 0; i < this->count; i++) {
+        offsets[i] = ArenaOffset(table, i);
+    }
+}
+
+uint8_t * BufferArena::Lease(uint8_t lease)
+{
+    if (lease >= count || !(table[lease].phases & phase)) return NULL;
+
+    return pool + offsets[lease];
+}
+
+bool BufferArena::Report(uint8_t line, char * buffer, uint16_t size)
+{
+    if (0 == line) {
+        snprintf(buffer, size, "Arena %lu B (idle %lu, motion %lu, offload %lu)",
+                 (unsigned long) ArenaFootprint(table, count, ARENA_ALL_PHASES),
+                 (unsigned long) ArenaFootprint(table, count, ARENA_IDLE),
+                 (unsigned long) ArenaFootprint(table, count, ARENA_MOTION),
+                 (unsigned long) ArenaFootprint(table, count, ARENA_OFFLOAD));
+        return true;
+    }
+
+    if (line > count) return false;
+
+    const ArenaLease_t & lease = table[line - 1];
+    snprintf(buffer, size, "Arena lease %s: %lu B at %lu, phases 0x%02x", lease.name,
+             (unsigned long) lease.size, (unsigned long) offsets[line - 1], lease.phases);
+    return true;
+}
@@ -0,0 +1,100 @@
+/*
+ *  BufferArena.h
+ *  Created: October 2026
+ *
+ *  A single static pool for the large working buffers that are only needed in
+ *  some flight phases (an MCB motion and an RPU offload never run at once).
+ *
+ *  Each buffer is a named lease with a size and the set of phases in which it
+ *  is live. Offsets are assigned at compile time: a lease is placed after
+ *  every earlier lease it shares a phase with, so leases that can be live
+ *  together never overlap, and a lease live in several phases keeps one
+ *  offset (its contents survive the phase change). Leases that never share a
+ *  phase reuse the same memory. Offsets are rounded up to ARENA_ALIGN so a
+ *  lease can hold structs. The pool size is the worst-case concurrent
+ *  footprint, computed by ArenaFootprint() from the lease table.
+ *
+ *  Lease() returns NULL for a lease that isn't live in the current phase, and
+ *  a lease's contents are undefined after a phase change that didn't keep it.
+ */
+
+#ifndef BUFFERARENA_H
+#define BUFFERARENA_H
+
+#include "Arduino.h"
+
+// bit flags, so that a lease can be live in several phases
+enum ArenaPhase_t : uint8_t {
+    ARENA_IDLE      = 0x01,
+    ARENA_MOTION    = 0x02,     // MCB motion, motion TM accumulating
+    ARENA_OFFLOAD   = 0x04,     // RPU profile record offload
+};
+
+#define ARENA_ALL_PHASES    (ARENA_IDLE | ARENA_MOTION | ARENA_OFFLOAD)
+#define ARENA_MAX_LEASES    8
+#define ARENA_ALIGN         4       // pool and lease alignment (power of two)
+
+struct ArenaLease_t {
+    const char * name;
+    uint32_t size;
+    uint8_t phases;     // ArenaPhase_t flags
+};
+
+// Offset of a lease in the pool (see above for the layout rule)
+constexpr uint32_t ArenaOffset(const ArenaLease_t * table, uint8_t index)
+{
+    uint32_t offset = 0;
+
+    for (uint8_t j = 0; j < index; j++) {
+        if (table[j].phases & table[index].phases) {
+            uint32_t end = ArenaOffset(table, j) + table[j].size;
+            if (end > offset) offset = end;
+        }
+    }
+
+    return (offset + ARENA_ALIGN - 1) & ~(uint32_t) (ARENA_ALIGN - 1);
+}
+
+// Bytes of the pool in use by the leases live in any of the given phases
+constexpr uint32_t ArenaFootprint(const ArenaLease_t * table, uint8_t count, uint8_t phases)
+{
+    uint32_t footprint = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (table[i].phases & phases) {
+            uint32_t end = ArenaOffset(table, i) + table[i].size;
+            if (end > footprint) footprint = end;
+        }
+    }
+
+    return footprint;
+}
+
+class BufferArena {
+public:
+    // The pool must be ArenaFootprint(table, count, ARENA_ALL_PHASES) bytes,
+    // aligned to ARENA_ALIGN
+    BufferArena(uint8_t * pool, const ArenaLease_t * table, uint8_t count);
+    ~BufferArena() { };
+
+    // Start a phase; leases not live in it are given up
+    void SetPhase(ArenaPhase_t new_phase) { phase = new_phase; }
+    ArenaPhase_t Phase() { return phase; }
+
+    // The lease's memory if it's live in the current phase, else NULL
+    uint8_t * Lease(uint8_t lease);
+    uint32_t LeaseSize(uint8_t lease) { return (lease < count) ? table[lease].size : 0; }
+
+    // Describe the layout for the log: line 0 is the per-phase footprint,
+    // lines 1..count one lease each. Returns false past the last line.
+    bool Report(uint8_t line, char * buffer, uint16_t size);
+
+private:
+    uint8_t * pool;
+    const ArenaLease_t * table;
+    uint8_t count;
+    uint32_t offsets[ARENA_MAX_LEASES];
+    ArenaPhase_t phase = ARENA_IDLE;
+};
+
+#endif /* BUFFERARENA_H */
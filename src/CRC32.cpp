@@ -0,0 +1,53 @@
+/*
+ *  CRC32.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the slicing-by-8 CRC-32.
+ */
+
+#include "CRC32.h"
+
+#define CRC32_POLYNOMIAL 0xEDB88320
+
+CRC32::CRC32()
+{
+    for (uint16_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? CRC32_POLYNOMIAL : 0);
+        }
+        table[0][i] = crc;
+    }
+
+    // table[k][i] is the CRC of byte i followed by k zero bytes
+    for (uint16_t i = 0; i < 256; i++) {
+        for (uint8_t k = 1; k < 8; k++) {
+            table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+        }
+    }
+}
+
+uint32_t CRC32::Update(uint32_t crc, const uint8_t * data, uint32_t length)
+{
+    // eight bytes per step; memcpy keeps unaligned loads legal (little-endian)
+    while (length >= 8) {
+        uint32_t low, high;
+        memcpy(&low, data, 4);
+        memcpy(&high, data + 4, 4);
+        low ^= crc;
+
+        crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF]
+            ^ table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24]
+            ^ table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF]
+            ^ table[1][(high >> 16) & 0xFF] ^ table[0][high >> 24];
+
+        data += 8;
+        length -= 8;
+    }
+
+    while (length--) {
+        crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xFF];
+    }
+
+    return crc;
+}
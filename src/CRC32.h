@@ -0,0 +1,35 @@
+/*
+ *  CRC32.h
+ *  Created: October 2026
+ *
+ *  Table-driven CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320, as used
+ *  by zlib) for end-to-end checks on dock-link record blocks.
+ *
+ *  Uses slicing-by-8: eight 256-entry tables let each step fold in eight
+ *  bytes with eight independent lookups instead of eight dependent ones. The
+ *  8 KB of tables are generated in RAM at construction, where lookups are
+ *  single-cycle on the Teensy 4.1.
+ */
+
+#ifndef CRC32_H
+#define CRC32_H
+
+#include "Arduino.h"
+
+class CRC32 {
+public:
+    CRC32();
+    ~CRC32() { };
+
+    // CRC-32 of a complete buffer
+    uint32_t Compute(const uint8_t * data, uint32_t length) { return ~Update(0xFFFFFFFF, data, length); }
+
+    // Advance a running (pre-inverted) CRC register over more data, so that
+    // Compute(a + b) == ~Update(Update(0xFFFFFFFF, a), b)
+    uint32_t Update(uint32_t crc, const uint8_t * data, uint32_t length);
+
+private:
+    uint32_t table[8][256];
+};
+
+#endif /* CRC32_H */
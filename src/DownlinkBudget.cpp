@@ -0,0 +1,93 @@
+/*
+ *  DownlinkBudget.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the Zephyr downlink byte accounting.
+ */
+
+#include "DownlinkBudget.h"
+
+void DownlinkBudget::SetCap(DownlinkCategory_t category, uint32_t bytes, uint8_t keep_one_in)
+{
+    caps[category] = bytes;
+    keep[category] = keep_one_in;
+}
+
+void DownlinkBudget::Note(DownlinkCategory_t category, uint32_t new_bytes, uint32_t now_ms)
+{
+    Advance(now_ms);
+
+    bins[category][current] += new_bytes;
+    bytes[category] += new_bytes;
+}
+
+bool DownlinkBudget::Allow(DownlinkCategory_t category, uint32_t now_ms)
+{
+    bool capped = (0 != caps[category] && WindowBytes(category, now_ms) >= caps[category])
+                  || (0 != total_cap && WindowTotal(now_ms) >= total_cap);
+    if (!capped) return true;
+
+    over[category]++;
+    if (0 != keep[category] && 0 == over[category] % keep[category]) return true;
+
+    refused[category]++;
+    return false;
+}
+
+uint32_t DownlinkBudget::HourBytes(DownlinkCategory_t category, uint32_t now_ms)
+{
+    Advance(now_ms);
+
+    return bins[category][current];
+}
+
+uint32_t DownlinkBudget::WindowBytes(DownlinkCategory_t category, uint32_t now_ms)
+{
+    Advance(now_ms);
+
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < DOWNLINK_BINS; i++) sum += bins[category][i];
+    return sum;
+}
+
+uint32_t DownlinkBudget::WindowTotal(uint32_t now_ms)
+{
+    uint32_t sum = 0;
+    for (uint8_t category = 0; category < DL_NUM_CATEGORIES; category++) {
+        sum += WindowBytes((DownlinkCategory_t) category, now_ms);
+    }
+    return sum;
+}
+
+const char * DownlinkBudget::CategoryName(DownlinkCategory_t category)
+{
+    switch (category) {
+    case DL_REPORT:
+        return "report";
+    case DL_TEXT:
+        return "text";
+    case DL_MCB:
+        return "mcb";
+    case DL_RPU:
+        return "rpu";
+    case DL_TCACK:
+        return "tcack";
+    default:
+        return "other";
+    }
+}
+
+void DownlinkBudget::Advance(uint32_t now_ms)
+{
+    uint32_t hours = (now_ms - bin_start_ms) / DOWNLINK_BIN_MS;
+    if (0 == hours) return;
+
+    // a long gap empties the whole window
+    uint8_t steps = (hours < DOWNLINK_BINS) ? hours : DOWNLINK_BINS;
+    for (uint8_t i = 0; i < steps; i++) {
+        current = (current + 1) % DOWNLINK_BINS;
+        for (uint8_t category = 0; category < DL_NUM_CATEGORIES; category++) bins[category][current] = 0;
+    }
+
+    bin_start_ms += hours * DOWNLINK_BIN_MS;
+}
@@ -0,0 +1,78 @@
+/*
+ *  DownlinkBudget.h
+ *  Created: October 2026
+ *
+ *  Bytes sent to the Zephyr, by TM category, over a rolling window of
+ *  DOWNLINK_BINS hourly bins (the last 24 hours). Each category and the total
+ *  can be capped; Allow() is asked only before traffic that can wait or be
+ *  thinned out, so the caps never hold back text, TC acks, offloads or
+ *  anything sent in reply to a TC. A capped category with a keep-one-in
+ *  count is decimated rather than stopped: every keep_one_in'th refused
+ *  request is let through.
+ *
+ *  Sizes are the caller's estimate of each message; the class only adds
+ *  them up.
+ */
+
+#ifndef DOWNLINKBUDGET_H
+#define DOWNLINKBUDGET_H
+
+#include "Arduino.h"
+
+#define DOWNLINK_BINS       24
+#define DOWNLINK_BIN_MS     3600000UL   // one hour
+
+enum DownlinkCategory_t : uint8_t {
+    DL_REPORT,      // RACHUTSREPORT
+    DL_TEXT,        // RACHUTSTEXT
+    DL_MCB,         // MCB* and real-time MCB TMs
+    DL_RPU,         // RPUREPORT, RPULORA, RPUOFFLOAD and profile records
+    DL_TCACK,       // RACHUTSTCACK
+    DL_OTHER,       // everything else, including non-TM messages
+    DL_NUM_CATEGORIES
+};
+
+class DownlinkBudget {
+public:
+    DownlinkBudget() { };
+    ~DownlinkBudget() { };
+
+    // Bytes allowed per window, 0 for no cap
+    void SetCap(DownlinkCategory_t category, uint32_t bytes, uint8_t keep_one_in = 0);
+    void SetTotalCap(uint32_t bytes) { total_cap = bytes; }
+
+    // Count a message as sent
+    void Note(DownlinkCategory_t category, uint32_t bytes, uint32_t now_ms);
+
+    // Whether a message that can wait should be sent now; a refusal is counted
+    bool Allow(DownlinkCategory_t category, uint32_t now_ms);
+
+    // Bytes in the current hour and in the whole window
+    uint32_t HourBytes(DownlinkCategory_t category, uint32_t now_ms);
+    uint32_t WindowBytes(DownlinkCategory_t category, uint32_t now_ms);
+    uint32_t WindowTotal(uint32_t now_ms);
+
+    // Statistics since boot
+    uint32_t Bytes(DownlinkCategory_t category) { return bytes[category]; }
+    uint32_t Refused(DownlinkCategory_t category) { return refused[category]; }   // held back by a cap
+
+    static const char * CategoryName(DownlinkCategory_t category);
+
+private:
+    // start new bins for the hours since the last call
+    void Advance(uint32_t now_ms);
+
+    uint32_t bins[DL_NUM_CATEGORIES][DOWNLINK_BINS] = {{0}};
+    uint8_t current = 0;
+    uint32_t bin_start_ms = 0;
+
+    uint32_t caps[DL_NUM_CATEGORIES] = {0};
+    uint8_t keep[DL_NUM_CATEGORIES] = {0};
+    uint32_t total_cap = 0;
+
+    uint32_t bytes[DL_NUM_CATEGORIES] = {0};
+    uint32_t refused[DL_NUM_CATEGORIES] = {0};
+    uint32_t over[DL_NUM_CATEGORIES] = {0};     // requests while capped, for decimation
+};
+
+#endif /* DOWNLINKBUDGET_H */
@@ -36,10 +36,10 @@ void StratoRachuts::EndOfFlightMode()
         break;
     case EF_LOOP:
         // nominal ops
-        log_debug("EF loop");
+        LOG_DEBUG("EF loop");
         break;
     case EF_ERROR_LANDING:
-        log_debug("EF error");
+        LOG_DEBUG("EF error");
         break;
     case EF_SHUTDOWN:
         // prep for shutdown
@@ -0,0 +1,99 @@
+/*
+ *  EventTrace.h
+ *  Created: October 2026
+ *
+ *  A binary trace of what the firmware did, for reconstructing the lead-up
+ *  to an anomaly: state and substate changes, action flags set and fired,
+ *  messages received from the MCB, PU and LoRa, TMs sent and TCs received.
+ *  Each event is 8 bytes, stamped with the CPU cycle counter, in a fixed ring
+ *  that overwrites the oldest events. Recording is a handful of stores, so it
+ *  stays on in flight.
+ *
+ *  The cycle counter wraps every few seconds, so a TRACE_MARK event carrying
+ *  millis() (low 24 bits: id = bits 16-23, value = bits 0-15) is inserted
+ *  ahead of the first event in each TRACE_MARK_MS interval. A reader times an
+ *  event from the cycles elapsed since the mark before it.
+ *
+ *  Only call Record() from the main loop, never from an interrupt.
+ */
+
+#ifndef EVENTTRACE_H
+#define EVENTTRACE_H
+
+#include "Arduino.h"
+
+#define TRACE_MARK_MS   1000
+
+enum TraceEvent_t : uint8_t {
+    TRACE_MARK,         // id, value: millis() bits 16-23 and 0-15
+    TRACE_SUBSTATE,     // value: inst_substate
+    TRACE_STATE,        // id: TimelineMachine_t, value: its ST_* state
+    TRACE_ACTION_SET,   // id: action, set directly by SetAction()
+    TRACE_ACTION_FIRE,  // id: action, fired by the scheduler
+    TRACE_MCB_RX,       // id: SerialMessage_t, value: message id
+    TRACE_PU_RX,        // id: SerialMessage_t, value: message id
+    TRACE_LORA_RX,      // id: packet length, value: first two bytes
+    TRACE_TM,           // id: ZephyrTXMsgType_t
+    TRACE_TC,           // value: telecommand
+};
+
+struct TraceRecord_t {
+    uint32_t cycles;
+    uint8_t event;      // TraceEvent_t
+    uint8_t id;
+    uint16_t value;
+};
+
+static_assert(sizeof(TraceRecord_t) == 8, "TraceRecord_t must pack to 8 bytes");
+
+class EventTrace {
+public:
+    // The ring must hold size records, a power of two
+    EventTrace(TraceRecord_t * ring, uint16_t size) : ring(ring), mask(size - 1) { };
+    ~EventTrace() { };
+
+    void Record(TraceEvent_t event, uint8_t id, uint16_t value)
+    {
+        uint32_t now_ms = millis();
+        if (0 == recorded || now_ms - mark_ms >= TRACE_MARK_MS) {
+            mark_ms = now_ms;
+            Put(TRACE_MARK, (uint8_t) (now_ms >> 16), (uint16_t) now_ms);
+        }
+        Put(event, id, value);
+    }
+
+    // Events recorded since boot; the ring holds the last Held() of them,
+    // numbered Recorded() - Held() to Recorded() - 1
+    uint32_t Recorded() { return recorded; }
+    uint16_t Held() { return (recorded > mask) ? mask + 1 : (uint16_t) recorded; }
+    const TraceRecord_t & At(uint32_t number) { return ring[number & mask]; }
+
+    static uint32_t Cycles();
+
+private:
+    void Put(TraceEvent_t event, uint8_t id, uint16_t value)
+    {
+        TraceRecord_t & record = ring[recorded & mask];
+        record.cycles = Cycles();
+        record.event = event;
+        record.id = id;
+        record.value = value;
+        recorded++;
+    }
+
+    TraceRecord_t * ring;
+    uint16_t mask;
+    uint32_t recorded = 0;
+    uint32_t mark_ms = 0;
+};
+
+inline uint32_t EventTrace::Cycles()
+{
+#ifdef ARM_DWT_CYCCNT
+    return ARM_DWT_CYCCNT;
+#else
+    return micros();
+#endif
+}
+
+#endif /* EVENTTRACE_H */
@@ -44,6 +44,7 @@ void StratoRachuts::FlightMode()
 {
     mode_code = "FL";
     SendPeriodicRACHUTSREPORT();
+    SendLoRaRecordTM(false);
     // todo: draw out flight mode state machine
     switch (inst_substate) {
     case FL_ENTRY:
@@ -54,14 +55,17 @@ void StratoRachuts::FlightMode()
         break;
     case FL_GPS_WAIT:
         // wait for the first GPS message from Zephyr to set the time before moving on
-        log_debug("Waiting on GPS time");
+        LOG_DEBUG("Waiting on GPS time");
         if (time_valid) {
             inst_substate = FLM_IDLE;
         }
         break;
     case FL_ERROR_LANDING:
         log_error("Landed in flight error");
-        SendTextTM("Entered flight error state", CRIT);
+        SendTextTM(TXT_FLIGHT_ERROR, CRIT);
+        SendTraceTM(); // what led up to it
+        LogPhaseTimeline();
+        SetArenaPhase(ARENA_IDLE);
         scheduler.ClearSchedule();
         mcb_motion_ongoing = false;
         mcb_motion = NO_MOTION;
@@ -71,7 +75,7 @@ void StratoRachuts::FlightMode()
         inst_substate = FL_ERROR_LOOP;
         break;
     case FL_ERROR_LOOP:
-        log_debug("FL error loop");
+        LOG_DEBUG("FL error loop");
         if (!mcb_low_power && CheckAction(RESEND_MCB_LP)) {
             scheduler.AddAction(RESEND_MCB_LP, MCB_RESEND_TIMEOUT);
             mcbComm.TX_ASCII(MCB_GO_LOW_POWER); // just constantly send
@@ -92,6 +96,8 @@ void StratoRachuts::FlightMode()
         break;
     case FL_EXIT:
         mcbComm.TX_ASCII(MCB_GO_LOW_POWER);
+        SetArenaPhase(ARENA_IDLE);
+        LogPhaseTimeline();
         log_nominal("Exiting FL");
         break;
     default:
@@ -104,9 +110,24 @@ void StratoRachuts::FlightMode()
 
 void StratoRachuts::ManualFlight()
 {
+    // the shared working buffers follow the substate (see BufferArena.h)
+    switch (inst_substate) {
+    case FLM_PU_OFFLOAD:
+        SetArenaPhase(ARENA_OFFLOAD);
+        break;
+    case FLM_MANUAL_MOTION:
+    case FLM_REDOCK:
+    case FLM_PROFILE:
+        SetArenaPhase(ARENA_MOTION);
+        break;
+    default:
+        SetArenaPhase(ARENA_IDLE);
+        break;
+    }
+
     switch (inst_substate) {
     case FLM_IDLE:
-        log_debug("FL Manual Idle");
+        LOG_DEBUG("FL Manual Idle");
         if (CheckAction(ACTION_REEL_IN)) {
             log_nominal("Reel in manual command");
             mcb_motion = MOTION_REEL_IN;
@@ -129,14 +150,17 @@ void StratoRachuts::ManualFlight()
         } else if (CheckAction(COMMAND_REDOCK)) {
             log_nominal("Redock manual command");
             mcb_motion = MOTION_IN_NO_LW;
+            phaseTimeline.Start(TL_REDOCK, millis());
             Flight_ReDock(true);
             inst_substate = FLM_REDOCK;
         } else if (CheckAction(COMMAND_MANUAL_PROFILE)) {
             log_nominal("Profile manual command");
+            phaseTimeline.Start(TL_PROFILE, millis());
             Flight_Profile(true);
             inst_substate = FLM_PROFILE;
         } else if (CheckAction(ACTION_OFFLOAD_PU)) {
             log_nominal("Offload PU Manual");
+            phaseTimeline.Start(TL_OFFLOAD, millis());
             Flight_PUOffload(true);
             inst_substate = FLM_PU_OFFLOAD;
         } else if (CheckAction(COMMAND_DOCKED_PROFILE)) {
@@ -165,18 +189,21 @@ void StratoRachuts::ManualFlight()
 
     case FLM_REDOCK:
         if (Flight_ReDock(false)) {
+            LogPhaseTimeline();
             inst_substate = FLM_IDLE;
         }
         break;
 
     case FLM_PU_OFFLOAD:
         if (Flight_PUOffload(false)) {
+            LogPhaseTimeline();
             inst_substate = FLM_IDLE;
         }
         break;
 
     case FLM_PROFILE:
         if (Flight_Profile(false)) {
+            LogPhaseTimeline();
             inst_substate = FLM_IDLE;
         }
         break;
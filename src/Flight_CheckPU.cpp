@@ -18,6 +18,7 @@ static bool resend_attempted = false;
 bool StratoRachuts::Flight_CheckPU(bool restart_state)
 {
     if (restart_state) checkpu_state = ST_ENTRY;
+    NoteState(TL_CHECK_PU, checkpu_state);
 
     switch (checkpu_state) {
     case ST_ENTRY:
@@ -29,6 +30,7 @@ bool StratoRachuts::Flight_CheckPU(bool restart_state)
         break;
 
     case ST_SEND_REQUEST:
+        TagPURequest(RPU_SEND_STATUS);
         puComm.TX_ASCII(RPU_SEND_STATUS);
         scheduler.AddAction(RESEND_PU_CHECK, PU_RESEND_TIMEOUT);
         if (resend_attempted) {
@@ -54,7 +56,7 @@ bool StratoRachuts::Flight_CheckPU(bool restart_state)
                 checkpu_state = ST_SEND_REQUEST;
             } else {
                 resend_attempted = false;
-                SendTextTM("PU not responding to status request", WARN);
+                SendTextTM(TXT_PU_NO_STATUS, WARN);
                 return true;
             }
         }
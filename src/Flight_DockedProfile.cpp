@@ -25,7 +25,7 @@ bool StratoRachuts::Flight_DockedProfile(bool restart_state)
     // is already commanded to standby unconditionally in TCHandler; this just
     // stops the state machine from continuing to wait on it.
     if (CheckAction(ACTION_CANCEL_MEASURE)) {
-        SendTextTM("Docked profile cancelled", FINE);
+        SendTextTM(TXT_DOCKED_CANCELLED, FINE);
         SetAction(ACTION_OFFLOAD_PU);
         return true;
     }
@@ -35,6 +35,7 @@ bool StratoRachuts::Flight_DockedProfile(bool restart_state)
     case ST_GO_MEASURE:
         pu_measure = false;
         resend_attempted = false;
+        TagPURequest(RPU_GO_MEASURE);
         puComm.TX_GoMeasure(docked_profile_time,
                             docked_profile_rate,
                             pibConfigs.rpu_bat_temp.Read(),
@@ -61,7 +62,7 @@ bool StratoRachuts::Flight_DockedProfile(bool restart_state)
                 profile_state = ST_GO_MEASURE;
             } else {
                 resend_attempted = false;
-                SendTextTM("RPU not responding to go-measure command", WARN);
+                SendTextTM(TXT_RPU_NO_GO_MEASURE, WARN);
                 return true;
             }
         }
@@ -69,7 +70,8 @@ bool StratoRachuts::Flight_DockedProfile(bool restart_state)
 
     case ST_MEASURE_WAIT:
         if (CheckAction(ACTION_END_DOCKED_PROFILE)) {
-            SendTextTM("Finished docked profile", FINE);
+            SendTextTM(TXT_DOCKED_FINISHED, FINE);
+            TagPURequest(RPU_GO_STANDBY);
             puComm.TX_GoStandby(pibConfigs.rpu_bat_temp.Read());
             SetAction(ACTION_OFFLOAD_PU);
             return true;
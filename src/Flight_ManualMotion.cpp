@@ -42,14 +42,14 @@ bool StratoRachuts::Flight_ManualMotion(bool restart_state)
             log_nominal("RA ACK");
         } else if (NAK == RA_ack_flag) {
             resend_attempted = false;
-            SendTextTM("Cannot perform motion, RA NAK", WARN);
+            SendTextTM(TXT_RA_NAK, WARN);
             return true;
         } else if (CheckAction(RESEND_RA)) {
             if (!resend_attempted) {
                 resend_attempted = true;
                 manualmotion_state = ST_SEND_RA;
             } else {
-                SendTextTM("Never received RAAck", WARN);
+                SendTextTM(TXT_NO_RA_ACK, WARN);
                 resend_attempted = false;
                 return true;
             }
@@ -58,7 +58,7 @@ bool StratoRachuts::Flight_ManualMotion(bool restart_state)
 
     case ST_START_MOTION:
         if (mcb_motion_ongoing) {
-            SendTextTM("Motion commanded while motion ongoing", WARN);
+            SendTextTM(TXT_MOTION_ONGOING, WARN);
             inst_substate = MODE_ERROR; // will force exit of Flight_Profile
             break;
         }
@@ -67,7 +67,7 @@ bool StratoRachuts::Flight_ManualMotion(bool restart_state)
             manualmotion_state = ST_VERIFY_MOTION;
             scheduler.AddAction(RESEND_MOTION_COMMAND, MCB_RESEND_TIMEOUT);
         } else {
-            SendTextTM("Motion start error", WARN);
+            SendTextTM(TXT_MOTION_START_ERROR, WARN);
             inst_substate = MODE_ERROR; // will force exit of Flight_Profile
         }
         break;
@@ -85,7 +85,7 @@ bool StratoRachuts::Flight_ManualMotion(bool restart_state)
                 manualmotion_state = ST_START_MOTION;
             } else {
                 resend_attempted = false;
-                SendTextTM("MCB never confirmed motion", WARN);
+                SendTextTM(TXT_MOTION_UNCONFIRMED, WARN);
                 inst_substate = MODE_ERROR; // will force exit of Flight_Profile
             }
         }
@@ -94,7 +94,7 @@ bool StratoRachuts::Flight_ManualMotion(bool restart_state)
     case ST_MONITOR_MOTION:
         if (CheckAction(ACTION_MOTION_STOP)) {
             // todo: verification of motion stop
-            SendTextTM("Commanded motion stop", FINE);
+            SendTextTM(TXT_MOTION_STOP, FINE);
             return true;
             break;
         }
@@ -0,0 +1,116 @@
+/*
+ *  Flight_PUBaud.cpp
+ *  Created: October 2026
+ *
+ *  Negotiates a faster dock-link baud rate with a docked RPU (see
+ *  LINK_SET_BAUD in LinkProtocol.h), and falls back to the base rate when the
+ *  faster link misbehaves.
+ */
+
+#include "StratoRachuts.h"
+
+enum PUBaudStates_t {
+    ST_ENTRY,
+    ST_WAIT_ACK,
+    ST_VERIFY,
+};
+
+static PUBaudStates_t pubaud_state = ST_ENTRY;
+static uint32_t target_baud = LINK_BASE_BAUD;
+
+bool StratoRachuts::Flight_PUBaud(bool restart_state)
+{
+    if (restart_state) pubaud_state = ST_ENTRY;
+    NoteState(TL_PU_BAUD, pubaud_state);
+
+    switch (pubaud_state) {
+    case ST_ENTRY:
+        target_baud = pibConfigs.pu_fast_baud.Read();
+
+        // disabled, or already running at the requested rate
+        if (target_baud <= LINK_BASE_BAUD || target_baud == pu_baud) return true;
+
+        pu_baud_acked = false;
+        pu_baud_naked = false;
+        puFramer.TX_Command(LINK_SET_BAUD, target_baud);
+        scheduler.AddAction(RESEND_PU_BAUD, PU_RESEND_TIMEOUT);
+        snprintf(log_array, LOG_ARRAY_SIZE, "PUBaud: requesting %lu baud", (unsigned long) target_baud);
+        log_nominal(log_array);
+        pubaud_state = ST_WAIT_ACK;
+        break;
+
+    case ST_WAIT_ACK:
+        if (pu_baud_acked) {
+            CheckAction(RESEND_PU_BAUD); // clear the timeout
+            SetPUBaud(target_baud);
+            Flight_CheckPU(true); // confirm the RPU answers at the new rate
+            pubaud_state = ST_VERIFY;
+        } else if (pu_baud_naked || CheckAction(RESEND_PU_BAUD)) {
+            // not fatal: a legacy RPU simply stays at the base rate
+            log_nominal("PUBaud: RPU did not accept rate change, staying at base rate");
+            return true;
+        }
+        break;
+
+    case ST_VERIFY:
+        if (Flight_CheckPU(false)) {
+            if (check_pu_success) {
+                snprintf(log_array, LOG_ARRAY_SIZE, "PUBaud: dock link at %lu baud", (unsigned long) pu_baud);
+                log_nominal(log_array);
+            } else {
+                PUBaudFallback("no status at new rate");
+            }
+            return true;
+        }
+        break;
+
+    default:
+        // unknown state, exit
+        return true;
+    }
+
+    return false; // assume incomplete
+}
+
+void StratoRachuts::SetPUBaud(uint32_t baud)
+{
+    if (baud == pu_baud) return;
+
+    // let any queued frame out at the old rate
+#ifdef PU_SERIAL_DMA
+    puDMA.flush();
+    puDMA.begin(baud);
+#else
+    PU_SERIAL.flush();
+    PU_SERIAL.begin(baud);
+#endif
+    pu_baud = baud;
+    pu_bad_frames = 0;
+}
+
+void StratoRachuts::PUBaudFallback(const char * reason)
+{
+    if (LINK_BASE_BAUD == pu_baud) return;
+
+    // best effort, at the rate the RPU should still be using; if it's missed
+    // the RPU reverts by itself after LINK_BAUD_IDLE_TIMEOUT
+    puFramer.TX_Command(LINK_SET_BAUD, LINK_BASE_BAUD);
+    SetPUBaud(LINK_BASE_BAUD);
+    pu_baud_fallbacks++;
+
+    snprintf(log_array, LOG_ARRAY_SIZE, "PU link fell back to %lu baud: %s", (unsigned long) LINK_BASE_BAUD, reason);
+    log_error(log_array);
+}
+
+void StratoRachuts::NotePUFrame(bool valid)
+{
+    if (valid) {
+        pu_bad_frames = 0;
+        return;
+    }
+
+    if (++pu_bad_frames >= PU_BAUD_FAIL_BURST) {
+        pu_bad_frames = 0;
+        PUBaudFallback("checksum failure burst");
+    }
+}
@@ -10,6 +10,7 @@ enum PUOffloadStates_t {
     ST_ENTRY,
     ST_GET_PU_STATUS,
     ST_WAIT_PU_STATUS,
+    ST_SET_BAUD,
     ST_REQUEST_PACKET,
     ST_WAIT_PACKET,
     ST_TM_ACK,
@@ -18,15 +19,18 @@ enum PUOffloadStates_t {
 static PUOffloadStates_t puoffload_state = ST_ENTRY;
 static bool resend_attempted = false;
 static uint8_t packet_num = 0;
+static uint32_t tm_sent_ms = 0;
 
 bool StratoRachuts::Flight_PUOffload(bool restart_state)
 {
     if (restart_state) puoffload_state = ST_ENTRY;
+    NoteState(TL_OFFLOAD, puoffload_state);
 
     switch (puoffload_state) {
     case ST_ENTRY:
         resend_attempted = false;
         packet_num = 0;
+        puBatch.StartOffload(PURecordBudget(), pibConfigs.pu_adaptive_batch.Read(), millis());
         puoffload_state = ST_GET_PU_STATUS;
         break;
 
@@ -37,12 +41,32 @@ bool StratoRachuts::Flight_PUOffload(bool restart_state)
 
     case ST_WAIT_PU_STATUS:
         if (Flight_CheckPU(false)) {
+            Flight_PUBaud(true);
+            puoffload_state = ST_SET_BAUD;
+        }
+        break;
+
+    case ST_SET_BAUD:
+        // a failed negotiation leaves the link at the base rate, so always continue
+        if (Flight_PUBaud(false)) {
+            SendLoRaHave(); // records already received over LoRa needn't be offloaded
             puoffload_state = ST_REQUEST_PACKET;
         }
         break;
 
     case ST_REQUEST_PACKET:
-        puComm.TX_ASCII(RPU_SEND_RECORDS);
+        CancelRecordRepair(); // a whole-block request supersedes any sub-block repair
+        if (resend_attempted) {
+            puBatch.NoteRetry();
+        } else {
+            puBatch.BeginBlock(millis());
+        }
+        TagPURequest(RPU_SEND_RECORDS);
+        if (pibConfigs.pu_adaptive_batch.Read()) {
+            puFramer.TX_Command(RPU_SEND_RECORDS, puBatch.Next());
+        } else {
+            puComm.TX_ASCII(RPU_SEND_RECORDS);
+        }
         scheduler.AddAction(RESEND_PU_RECORD, PU_RESEND_TIMEOUT);
         record_received = false;
         pu_no_more_records = false;
@@ -55,29 +79,34 @@ bool StratoRachuts::Flight_PUOffload(bool restart_state)
             packet_num++;
 
             RPURecord first_record;
-            if (first_record.decode(puComm.binary_rx.bin_buffer, RPU_RECORD_BYTES)) {
+            if (first_record.decode(pu_record + pu_record_offset, RPU_RECORD_BYTES)) {
                 snprintf(log_array, LOG_ARRAY_SIZE, "Profile block %u (%u bytes) recvd, first record elapsed_s=%lu",
-                         packet_num, puComm.binary_rx.bin_length, (unsigned long)first_record.getElapsedS());
+                         packet_num, pu_record_length, (unsigned long)first_record.getElapsedS());
                 log_nominal(log_array);
             }
 
             SendRPUREPORT(packet_num);
+            tm_sent_ms = millis();
             puoffload_state = ST_TM_ACK;
             scheduler.AddAction(RESEND_TM, ZEPHYR_RESEND_TIMEOUT);
             break;
         } else if (pu_no_more_records) {
             pu_no_more_records = false;
             log_nominal("No more profile records");
+            SendOffloadSummary();
             return true;
         }
 
         if (CheckAction(RESEND_PU_RECORD)) {
+            PUBaudFallback("profile record timeout");
             if (!resend_attempted) {
                 resend_attempted = true;
                 puoffload_state = ST_REQUEST_PACKET;
             } else {
                 resend_attempted = false;
-                SendTextTM("PU not successful in sending profile record", WARN);
+                SendTextTM(TXT_OFFLOAD_RECORD_FAIL, WARN);
+                puBatch.LostBlock();
+                SendOffloadSummary();
                 return true;
             }
         }
@@ -87,9 +116,11 @@ bool StratoRachuts::Flight_PUOffload(bool restart_state)
         // Loop straight back to request the next batch; the PU status is checked
         // once at ST_ENTRY, not before every batch.
         if (ACK == TM_ack_flag) {
+            puBatch.EndBlock(millis() - tm_sent_ms, true);
             resend_attempted = false;
             puoffload_state = ST_REQUEST_PACKET;
         } else if (NAK == TM_ack_flag || CheckAction(RESEND_TM)) {
+            puBatch.EndBlock(millis() - tm_sent_ms, false);
             // attempt one resend
             log_error("Needed to resend TM");
             ZephyrTXpoke(ZEPHYRTX_TM); // message is still saved in XMLWriter, no need to reconstruct
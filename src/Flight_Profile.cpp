@@ -34,6 +34,7 @@ static uint8_t redock_count = 0;
 bool StratoRachuts::Flight_Profile(bool restart_state)
 {
     if (restart_state) profile_state = ST_ENTRY;
+    NoteState(TL_PROFILE, profile_state);
 
     switch (profile_state) {
     case ST_ENTRY:
@@ -46,13 +47,13 @@ bool StratoRachuts::Flight_Profile(bool restart_state)
         break;
 
     case ST_WAIT_RAACK:
-        log_debug("FLA wait RA Ack");
+        LOG_DEBUG("FLA wait RA Ack");
         if (ACK == RA_ack_flag) { // set by Zephyr RA ack handler
             profile_state = ST_SET_PU_PROFILE;
             resend_attempted = false;
             log_nominal("RA ACK");
         } else if (NAK == RA_ack_flag) {
-            SendTextTM("Cannot perform motion, RA NAK", WARN);
+            SendTextTM(TXT_RA_NAK, WARN);
             resend_attempted = false;
             return true;
         } else if (CheckAction(RESEND_RA)) {
@@ -60,7 +61,7 @@ bool StratoRachuts::Flight_Profile(bool restart_state)
                 resend_attempted = true;
                 profile_state = ST_SEND_RA;
             } else {
-                SendTextTM("Never received RAAck", WARN);
+                SendTextTM(TXT_NO_RA_ACK, WARN);
                 resend_attempted = false;
                 return true;
             }
@@ -90,7 +91,7 @@ bool StratoRachuts::Flight_Profile(bool restart_state)
                 profile_state = ST_SET_PU_PROFILE;
             } else {
                 resend_attempted = false;
-                SendTextTM("RPU not responding to go-measure command", WARN);
+                SendTextTM(TXT_RPU_NO_GO_MEASURE, WARN);
                 return true;
             }
         }
@@ -104,14 +105,14 @@ bool StratoRachuts::Flight_Profile(bool restart_state)
         break;
 
     case ST_REEL_OUT:
-        log_debug("FLA reel out");
+        LOG_DEBUG("FLA reel out");
         mcb_motion = MOTION_REEL_OUT;
         profile_state = ST_START_MOTION;
         resend_attempted = false;
         break;
 
     case ST_REEL_IN:
-        log_debug("FLA reel in");
+        LOG_DEBUG("FLA reel in");
         mcb_motion = MOTION_REEL_IN;
         profile_state = ST_START_MOTION;
         resend_attempted = false;
@@ -125,7 +126,7 @@ bool StratoRachuts::Flight_Profile(bool restart_state)
         break;
 
     case ST_DOCK:
-        log_debug("FLA dock");
+        LOG_DEBUG("FLA dock");
         mcb_motion = MOTION_DOCK;
         profile_state = ST_START_MOTION;
         resend_attempted = false;
@@ -141,12 +142,13 @@ bool StratoRachuts::Flight_Profile(bool restart_state)
         if (pibConfigs.pu_docked.Read()) { // written by Flight_CheckPU from RPU status
             mcbComm.TX_ASCII(MCB_ZERO_REEL);
             delay(100);
+            TagMCBRequest(MCB_GO_LOW_POWER);
             mcbComm.TX_ASCII(MCB_GO_LOW_POWER);
             scheduler.AddAction(RESEND_MCB_LP, MCB_RESEND_TIMEOUT);
             profile_state = ST_CONFIRM_MCB_LP;
         } else {
             if ((pibConfigs.num_redock.Read() + 1) == ++redock_count) {
-                SendTextTM("No dock! Exceeded allowable number of redock attempts", CRIT);
+                SendTextTM(TXT_NO_DOCK, CRIT);
                 inst_substate = MODE_ERROR; // will force exit of Flight_Profile
             } else {
                 deploy_length = pibConfigs.redock_out.Read();
@@ -165,9 +167,9 @@ bool StratoRachuts::Flight_Profile(bool restart_state)
         break;
 
     case ST_START_MOTION:
-        log_debug("FLA start motion");
+        LOG_DEBUG("FLA start motion");
         if (mcb_motion_ongoing) { // set in MCBRouter when MCB acks motion command
-            SendTextTM("Motion commanded while motion ongoing", WARN);
+            SendTextTM(TXT_MOTION_ONGOING, WARN);
             inst_substate = MODE_ERROR; // will force exit of Flight_Profile
             break;
         }
@@ -176,13 +178,13 @@ bool StratoRachuts::Flight_Profile(bool restart_state)
             profile_state = ST_VERIFY_MOTION;
             scheduler.AddAction(RESEND_MOTION_COMMAND, MCB_RESEND_TIMEOUT);
         } else {
-            SendTextTM("Motion start error", WARN);
+            SendTextTM(TXT_MOTION_START_ERROR, WARN);
             inst_substate = MODE_ERROR; // will force exit of Flight_Profile
         }
         break;
 
     case ST_VERIFY_MOTION:
-        log_debug("FLA verify motion");
+        LOG_DEBUG("FLA verify motion");
         if (mcb_motion_ongoing) { // set in MCBRouter when MCB acks motion command
             log_nominal("MCB commanded motion");
             scheduler.AddAction(ACTION_MOTION_TIMEOUT, max_profile_seconds);
@@ -195,17 +197,17 @@ bool StratoRachuts::Flight_Profile(bool restart_state)
                 profile_state = ST_START_MOTION;
             } else {
                 resend_attempted = false;
-                SendTextTM("MCB never confirmed motion", WARN);
+                SendTextTM(TXT_MOTION_UNCONFIRMED, WARN);
                 inst_substate = MODE_ERROR; // will force exit of Flight_Profile
             }
         }
         break;
 
     case ST_MONITOR_MOTION:
-        log_debug("FLA monitor motion");
+        LOG_DEBUG("FLA monitor motion");
 
         if (CheckAction(ACTION_MOTION_STOP)) {
-            SendTextTM("Commanded motion stop in autonomous", WARN);
+            SendTextTM(TXT_MOTION_STOP_AUTO, WARN);
             inst_substate = MODE_ERROR; // will force exit of Flight_Profile
             break;
         }
@@ -227,7 +229,7 @@ bool StratoRachuts::Flight_Profile(bool restart_state)
                     log_nominal(log_array);
                     profile_state = ST_DWELL;
                 } else {
-                    SendTextTM("Unable to schedule dwell", CRIT);
+                    SendTextTM(TXT_DWELL_SCHEDULE, CRIT);
                     inst_substate = MODE_ERROR; // will force exit of Flight_Profile
                 }
                 break;
@@ -251,7 +253,7 @@ bool StratoRachuts::Flight_Profile(bool restart_state)
         break;
 
     case ST_DWELL:
-        log_debug("FLA dwell");
+        LOG_DEBUG("FLA dwell");
         if (CheckAction(ACTION_END_DWELL)) {
             log_nominal("Finished dwell");
             profile_state = ST_REEL_IN;
@@ -266,10 +268,11 @@ bool StratoRachuts::Flight_Profile(bool restart_state)
         } else if (CheckAction(RESEND_MCB_LP)) {
             if (!resend_attempted) {
                 resend_attempted = true;
+                TagMCBRequest(MCB_GO_LOW_POWER);
                 mcbComm.TX_ASCII(MCB_GO_LOW_POWER);
             } else {
                 resend_attempted = false;
-                SendTextTM("MCB never powered off after profile", WARN);
+                SendTextTM(TXT_MCB_NOT_OFF, WARN);
                 inst_substate = MODE_ERROR; // will force exit of Flight_Profile
             }
         }
@@ -22,6 +22,7 @@ static bool resend_attempted = false;
 bool StratoRachuts::Flight_ReDock(bool restart_state)
 {
     if (restart_state) redock_state = ST_ENTRY;
+    NoteState(TL_REDOCK, redock_state);
 
     switch (redock_state) {
     case ST_ENTRY:
@@ -48,7 +49,7 @@ bool StratoRachuts::Flight_ReDock(bool restart_state)
 
     case ST_START_MOTION:
         if (mcb_motion_ongoing) {
-            SendTextTM("Motion commanded while motion ongoing", WARN);
+            SendTextTM(TXT_MOTION_ONGOING, WARN);
             inst_substate = MODE_ERROR; // will force exit of Flight_Profile
         }
 
@@ -56,7 +57,7 @@ bool StratoRachuts::Flight_ReDock(bool restart_state)
             redock_state = ST_VERIFY_MOTION;
             scheduler.AddAction(RESEND_MOTION_COMMAND, MCB_RESEND_TIMEOUT);
         } else {
-            SendTextTM("Motion start error", WARN);
+            SendTextTM(TXT_MOTION_START_ERROR, WARN);
             inst_substate = MODE_ERROR; // will force exit of Flight_Profile
         }
         break;
@@ -73,7 +74,7 @@ bool StratoRachuts::Flight_ReDock(bool restart_state)
                 redock_state = ST_START_MOTION;
             } else {
                 resend_attempted = false;
-                SendTextTM("MCB never confirmed motion", WARN);
+                SendTextTM(TXT_MOTION_UNCONFIRMED, WARN);
                 inst_substate = MODE_ERROR; // will force exit of Flight_Profile
             }
         }
@@ -82,7 +83,7 @@ bool StratoRachuts::Flight_ReDock(bool restart_state)
     case ST_MONITOR_MOTION:
         if (CheckAction(ACTION_MOTION_STOP)) {
             // todo: verification of motion stop
-            SendTextTM("Commanded motion stop", FINE);
+            SendTextTM(TXT_MOTION_STOP, FINE);
             return true;
             break;
         }
@@ -93,6 +94,7 @@ bool StratoRachuts::Flight_ReDock(bool restart_state)
         break;
 
     case ST_CHECK_PU:
+        TagPURequest(RPU_SEND_STATUS);
         puComm.TX_ASCII(RPU_SEND_STATUS);
         scheduler.AddAction(RESEND_PU_CHECK, PU_RESEND_TIMEOUT);
         redock_state = ST_WAIT_PU;
@@ -112,7 +114,7 @@ bool StratoRachuts::Flight_ReDock(bool restart_state)
                 redock_state = ST_CHECK_PU;
             } else {
                 resend_attempted = false;
-                SendTextTM("PU not responding to status request", WARN);
+                SendTextTM(TXT_PU_NO_STATUS, WARN);
                 return true;
             }
         }
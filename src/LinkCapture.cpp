@@ -0,0 +1,81 @@
+/*
+ *  LinkCapture.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the received-byte capture ring.
+ */
+
+#include "LinkCapture.h"
+
+LinkCapture::LinkCapture(uint8_t * ring, uint32_t size)
+    : ring(ring)
+    , size(size)
+{
+}
+
+void LinkCapture::Add(CaptureLink_t link, const uint8_t * data, uint32_t length, uint32_t now_us)
+{
+#ifdef ARM_DWT_CYCCNT
+    uint32_t start_cycles = ARM_DWT_CYCCNT;
+#endif
+
+    while (length > 0) {
+        uint8_t chunk = (length > CAPTURE_MAX_DATA) ? CAPTURE_MAX_DATA : (uint8_t) length;
+        uint32_t record = CAPTURE_HEADER_SIZE + chunk;
+        if (record > size) break;
+
+        // make room by dropping whole records from the tail
+        while (size - used < record) {
+            uint32_t old = CAPTURE_HEADER_SIZE + ring[(tail + 1) % size];
+            tail = (tail + old) % size;
+            used -= old;
+            overwritten++;
+        }
+
+        uint8_t header[CAPTURE_HEADER_SIZE] = {(uint8_t) link, chunk, (uint8_t) now_us,
+                                               (uint8_t) (now_us >> 8), (uint8_t) (now_us >> 16),
+                                               (uint8_t) (now_us >> 24)};
+        Put(header, CAPTURE_HEADER_SIZE);
+        Put(data, chunk);
+
+        bytes += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+
+#ifdef ARM_DWT_CYCCNT
+    cycles += ARM_DWT_CYCCNT - start_cycles;
+#endif
+}
+
+void LinkCapture::Clear()
+{
+    head = 0;
+    tail = 0;
+    used = 0;
+}
+
+uint32_t LinkCapture::Read(uint32_t offset, uint8_t * out, uint32_t length)
+{
+    if (offset >= used) return 0;
+    if (length > used - offset) length = used - offset;
+
+    uint32_t start = (tail + offset) % size;
+    uint32_t first = (length > size - start) ? size - start : length;
+
+    memcpy(out, ring + start, first);
+    memcpy(out + first, ring, length - first);
+    return length;
+}
+
+// the caller has made room
+void LinkCapture::Put(const uint8_t * data, uint32_t length)
+{
+    uint32_t first = (length > size - head) ? size - head : length;
+
+    memcpy(ring + head, data, first);
+    memcpy(ring, data + first, length - first);
+
+    head = (head + length) % size;
+    used += length;
+}
@@ -0,0 +1,71 @@
+/*
+ *  LinkCapture.h
+ *  Created: October 2026
+ *
+ *  A ring of every byte received on the MCB and PU links and every LoRa
+ *  packet, with microsecond timestamps, for reconstructing what the PIB saw
+ *  after an anomaly. The ring lives in RAM2 (DMAMEM) and is dumped on the
+ *  debug port (see DumpLinkCapture()); when full, the oldest records are
+ *  overwritten.
+ *
+ *  Each record is a 6 byte header followed by the data:
+ *      [link][length][micros() as 4 bytes LE][length bytes]
+ *  with length 1-255; longer reads are split over several records. Serial
+ *  records hold the bytes as read from the link in one call, so a replay
+ *  that feeds each record to its framer at its timestamp reproduces the
+ *  reads the firmware made. LoRa records hold one whole packet.
+ *
+ *  The time spent capturing is counted in CPU cycles where the DWT cycle
+ *  counter is available, so the overhead can be checked in flight.
+ */
+
+#ifndef LINKCAPTURE_H
+#define LINKCAPTURE_H
+
+#include "Arduino.h"
+
+#define CAPTURE_HEADER_SIZE     6
+#define CAPTURE_MAX_DATA        255
+
+enum CaptureLink_t : uint8_t {
+    CAPTURE_MCB,
+    CAPTURE_PU,
+    CAPTURE_LORA,
+};
+
+class LinkCapture {
+public:
+    // The ring must hold at least one whole record
+    LinkCapture(uint8_t * ring, uint32_t size);
+    ~LinkCapture() { };
+
+    void Add(CaptureLink_t link, const uint8_t * data, uint32_t length, uint32_t now_us);
+    void Clear();
+
+    // Copy up to length bytes of the ring, oldest first, starting offset bytes
+    // in; returns the number copied
+    uint32_t Read(uint32_t offset, uint8_t * out, uint32_t length);
+
+    // Bytes currently held, headers included
+    uint32_t Used() { return used; }
+
+    // Statistics since boot
+    uint32_t Bytes() { return bytes; }              // data bytes captured
+    uint32_t Overwritten() { return overwritten; }  // records lost to wrap-around
+    uint32_t Cycles() { return cycles; }            // CPU cycles spent in Add
+
+private:
+    void Put(const uint8_t * data, uint32_t length);
+
+    uint8_t * ring;
+    uint32_t size;
+    uint32_t head = 0;          // next byte written
+    uint32_t tail = 0;          // oldest record's header
+    uint32_t used = 0;
+
+    uint32_t bytes = 0;
+    uint32_t overwritten = 0;
+    uint32_t cycles = 0;
+};
+
+#endif /* LINKCAPTURE_H */
@@ -0,0 +1,129 @@
+/*
+ *  LinkProtocol.h
+ *  Created: October 2026
+ *
+ *  PIB extensions to the SerialComm message sets used on the MCB and PU links
+ *  (MCBComm/RPUComm). The peer firmware must use the same values. Ids are taken
+ *  from the top of the 8-bit range to stay clear of the library enums.
+ */
+
+#ifndef LINKPROTOCOL_H
+#define LINKPROTOCOL_H
+
+// Sequence tag, sent as its own ASCII frame immediately ahead of a tagged
+// request or reply: #250,<seq>;<checksum>;
+// Only sent to a peer when tagging is enabled for its link (PIBConfigs), so an
+// untagged legacy peer never sees one.
+#define LINK_SEQ_TAG    250
+
+// Dock-link baud rate change, PIB to RPU: #251,<baud>;<checksum>;
+// The RPU ACKs (?251,1) at the current rate, then both ends switch. The PIB
+// confirms the new rate with a status request and falls back to
+// LINK_BASE_BAUD if that fails. The RPU must also return to LINK_BASE_BAUD on
+// its own when it hears no valid frame for LINK_BAUD_IDLE_TIMEOUT seconds, and
+// on every power-up, so a fallback the RPU never hears still converges.
+#define LINK_SET_BAUD           251
+#define LINK_BASE_BAUD          115200
+#define LINK_BAUD_IDLE_TIMEOUT  30
+
+// FEC-coded RPU_PROFILE_RECORD payload (see ReedSolomon.h). The record data is
+// split into Reed-Solomon codewords of FEC_CODEWORD_DATA(nsym) data symbols
+// (the last one zero-padded) plus nsym parity symbols each. Consecutive groups
+// of <depth> codewords are interleaved symbol by symbol, so a burst of up to
+// depth * nsym/2 corrupted bytes costs each codeword at most nsym/2 symbols.
+// The final group may hold fewer than <depth> codewords and is interleaved
+// across however many it holds.
+//   header (FEC_HEADER_SIZE bytes):
+//     [0..1] FEC_MAGIC_0, FEC_MAGIC_1
+//     [2]    FEC_VERSION
+//     [3]    nsym: parity symbols per codeword, even, 2..RS_MAX_PARITY
+//     [4]    depth: interleave depth, 1..FEC_MAX_DEPTH
+//     [5]    reserved (0)
+//     [6..7] record data length, little-endian
+//   followed by the interleaved groups, RS_BLOCK_SIZE bytes per codeword
+#define FEC_MAGIC_0     0xFE
+#define FEC_MAGIC_1     0xC5
+#define FEC_VERSION     1
+#define FEC_HEADER_SIZE 8
+#define FEC_MAX_DEPTH   8
+#define FEC_CODEWORD_DATA(nsym) (255 - (nsym))
+
+// CRC-checked RPU_PROFILE_RECORD payload (inside the FEC coding when both are
+// used). The record data is divided into sub-blocks of sub_size bytes (the
+// last may be short), each with its own CRC-32 (see CRC32.h), so that only
+// damaged sub-blocks need to be sent again.
+//   header (CRC_HEADER_SIZE(num_sub) bytes):
+//     [0..1]   CRC_MAGIC_0, CRC_MAGIC_1
+//     [2]      flags: CRC_FLAG_PARTIAL if only the sub-blocks in mask follow
+//     [3]      num_sub: 1..CRC_MAX_SUBBLOCKS
+//     [4..5]   sub_size, little-endian
+//     [6..7]   record data length, little-endian
+//     [8..11]  mask of the sub-blocks present (bit n = sub-block n), little-endian
+//     [12..15] CRC-32 of the whole record data, little-endian
+//     [16..]   CRC-32 of each sub-block, num_sub entries, little-endian
+//   followed by the data of the sub-blocks present, in order
+// Sub-block re-request, PIB to RPU: #252,<mask>;<checksum>; the RPU answers
+// with a partial record (unencoded, same header apart from flags and mask)
+// holding just those sub-blocks, and still waits for the record's ACK.
+#define LINK_RESEND_SUB         252
+#define CRC_MAGIC_0             0xC3
+#define CRC_MAGIC_1             0x32
+#define CRC_FLAG_PARTIAL        0x01
+#define CRC_MAX_SUBBLOCKS       32
+#define CRC_WHOLE_OFFSET        12
+#define CRC_SUB_OFFSET(n)       (16 + 4 * (n))
+#define CRC_HEADER_SIZE(num_sub) CRC_SUB_OFFSET(num_sub)
+
+// Profile records streamed by the RPU over LoRa while undocked. Each LoRa
+// packet carries as many whole records as fit in it, numbered by a
+// fragment sequence that restarts at 0 for each profile:
+//     [0..1]  LORA_FRAG_MAGIC_0, LORA_FRAG_MAGIC_1
+//     [2]     profile id (low byte of the id sent with LINK_LORA_STREAM)
+//     [3]     record count, | LORA_FRAG_LAST on the profile's final fragment
+//     [4..5]  fragment sequence, little-endian, below LORA_FRAG_MAX_SEQ
+//     [6..9]  CRC-32 of the records, little-endian
+//     [10..]  the records, RPU_RECORD_BYTES each
+// Streaming request, PIB to RPU before undocking: #253,<profile id>;<checksum>;
+// Fragments already received, PIB to RPU before an offload, one frame per run
+// of consecutive fragments: #254,<id << 24 | first << 12 | last>;<checksum>;
+// so the RPU need only offload the records LoRa missed. Both are advisory; an
+// RPU that ignores them offloads everything, and the ground de-duplicates.
+#define LINK_LORA_STREAM        253
+#define LINK_LORA_HAVE          254
+#define LORA_FRAG_MAGIC_0       0x4C
+#define LORA_FRAG_MAGIC_1       0xF5
+#define LORA_FRAG_LAST          0x80
+#define LORA_FRAG_HEADER_SIZE   10
+#define LORA_FRAG_MAX_SEQ       4096
+
+// LoRa radio settings for the next profile, PIB to docked RPU:
+// #249,<spreading factor << 24 | bandwidth in Hz>;<checksum>;
+// Both ends switch when the RPU ACKs. Both return to the base settings (SF and
+// BANDWIDTH in StratoRachuts.h) when the RPU next docks or powers up, and the
+// PIB also returns to them when it hears nothing for three LoRa status periods.
+#define LINK_LORA_RATE          249
+
+// Commands to an undocked RPU over LoRa. The RPU must listen whenever it isn't
+// transmitting. Each command is a binary LoRa packet:
+//     [0..1]  LORA_CMD_MAGIC_0, LORA_CMD_MAGIC_1
+//     [2]     command sequence
+//     [3]     message id: RPU_SEND_STATUS, RPU_GO_STANDBY (parameter = battery
+//             setpoint in hundredths of a degree), RPU_SET_STATUS_RATE, or
+//             LINK_SET_MEAS_RATE (parameter = seconds between measurements)
+//     [4..7]  parameter, little-endian
+//     [8..11] CRC-32 of bytes 0..7, little-endian
+// and the RPU answers each with an ACK packet:
+//     [0..1]  LORA_CMD_MAGIC_0, LORA_ACK_MAGIC_1
+//     [2..3]  sequence and message id of the command
+//     [4]     1 = ACK, 0 = NAK
+//     [5..8]  CRC-32 of bytes 0..4, little-endian
+// The PIB resends until it hears the ACK, so the RPU must ACK a repeated
+// sequence again without acting on it twice.
+#define LINK_SET_MEAS_RATE      248
+#define LORA_CMD_MAGIC_0        0x4C
+#define LORA_CMD_MAGIC_1        0xC0
+#define LORA_ACK_MAGIC_1        0xAC
+#define LORA_CMD_SIZE           12
+#define LORA_ACK_SIZE           9
+
+#endif /* LINKPROTOCOL_H */
@@ -0,0 +1,83 @@
+/*
+ *  LinkSequencer.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the PIB-side request/reply correlation table.
+ */
+
+#include "LinkSequencer.h"
+
+uint8_t LinkSequencer::Open(uint8_t request_id, uint32_t now_ms)
+{
+    uint8_t slot = 0;
+
+    // prefer a free slot, otherwise recycle the oldest open request
+    for (uint8_t i = 0; i < SEQ_MAX_OUTSTANDING; i++) {
+        if (!slots[i].open) {
+            slot = i;
+            break;
+        }
+        if ((now_ms - slots[i].sent_ms) > (now_ms - slots[slot].sent_ms)) slot = i;
+    }
+
+    if (slots[slot].open) Close(slot, true);
+
+    slots[slot].request_id = request_id;
+    slots[slot].seq = next_seq++;
+    slots[slot].sent_ms = now_ms;
+    slots[slot].open = true;
+
+    return slots[slot].seq;
+}
+
+SeqMatch_t LinkSequencer::Match(uint8_t seq, uint8_t request_id)
+{
+    for (uint8_t i = 0; i < SEQ_MAX_OUTSTANDING; i++) {
+        if (!slots[i].open || slots[i].seq != seq) continue;
+
+        if (slots[i].request_id != request_id) {
+            unsolicited++;
+            return SEQ_MISMATCHED;
+        }
+
+        Close(i, false);
+        matched++;
+        return SEQ_MATCHED;
+    }
+
+    // search the history newest-first so a reused sequence number resolves to its latest use
+    for (uint8_t n = 1; n <= SEQ_HISTORY_SIZE; n++) {
+        SeqClosed_t & closed = history[(uint8_t) (history_index + SEQ_HISTORY_SIZE - n) % SEQ_HISTORY_SIZE];
+        if (!closed.valid || closed.seq != seq) continue;
+
+        if (closed.expired) {
+            late++;
+            return SEQ_LATE;
+        }
+
+        duplicates++;
+        return SEQ_DUPLICATE;
+    }
+
+    unsolicited++;
+    return SEQ_UNSOLICITED;
+}
+
+void LinkSequencer::Expire(uint32_t now_ms, uint32_t timeout_ms)
+{
+    for (uint8_t i = 0; i < SEQ_MAX_OUTSTANDING; i++) {
+        if (slots[i].open && (now_ms - slots[i].sent_ms) >= timeout_ms) {
+            Close(i, true);
+        }
+    }
+}
+
+void LinkSequencer::Close(uint8_t slot, bool expired)
+{
+    slots[slot].open = false;
+
+    history[history_index].seq = slots[slot].seq;
+    history[history_index].expired = expired;
+    history[history_index].valid = true;
+    history_index = (history_index + 1) % SEQ_HISTORY_SIZE;
+}
@@ -0,0 +1,77 @@
+/*
+ *  LinkSequencer.h
+ *  Created: October 2026
+ *
+ *  PIB-side request/reply correlation for the sequence-tagged MCB and PU links.
+ *
+ *  Each outstanding request is given an 8-bit sequence number, sent to the
+ *  peer in a tag frame just ahead of the request (see SerialFramer::TX_Tag).
+ *  A peer that supports tagging echoes the number in a tag frame ahead of its
+ *  reply, and the router matches it here:
+ *    - a reply to an open request closes it (matched)
+ *    - a second reply to an already-closed request is a duplicate
+ *    - a reply to a request that timed out before it arrived is late
+ *  Duplicates and late replies are dropped by the router and counted. Replies
+ *  without a tag (legacy peers) bypass the table entirely.
+ */
+
+#ifndef LINKSEQUENCER_H
+#define LINKSEQUENCER_H
+
+#include "Arduino.h"
+
+#define SEQ_MAX_OUTSTANDING 8   // requests in flight per link
+#define SEQ_HISTORY_SIZE    16  // closed requests remembered for duplicate/late detection
+
+enum SeqMatch_t : uint8_t {
+    SEQ_MATCHED,
+    SEQ_DUPLICATE,
+    SEQ_LATE,
+    SEQ_MISMATCHED,     // tagged reply whose type doesn't fit the request
+    SEQ_UNSOLICITED,    // tagged reply matching no known request
+};
+
+class LinkSequencer {
+public:
+    LinkSequencer() { };
+    ~LinkSequencer() { };
+
+    // Open a slot for a new request and return the sequence number to tag it
+    // with. If every slot is in use the oldest request is expired to make room.
+    uint8_t Open(uint8_t request_id, uint32_t now_ms);
+
+    // Match a tagged reply, given the id of the request it answers
+    SeqMatch_t Match(uint8_t seq, uint8_t request_id);
+
+    // Expire open requests that have waited longer than timeout_ms
+    void Expire(uint32_t now_ms, uint32_t timeout_ms);
+
+    // Counters since boot
+    uint32_t matched = 0;
+    uint32_t duplicates = 0;
+    uint32_t late = 0;
+    uint32_t unsolicited = 0;
+
+private:
+    struct SeqSlot_t {
+        uint32_t sent_ms;
+        uint8_t request_id;
+        uint8_t seq;
+        bool open;
+    };
+
+    struct SeqClosed_t {
+        uint8_t seq;
+        bool expired;   // closed by timeout rather than by a reply
+        bool valid;
+    };
+
+    void Close(uint8_t slot, bool expired);
+
+    SeqSlot_t slots[SEQ_MAX_OUTSTANDING] = {};
+    SeqClosed_t history[SEQ_HISTORY_SIZE] = {};
+    uint8_t history_index = 0;
+    uint8_t next_seq = 0;
+};
+
+#endif /* LINKSEQUENCER_H */
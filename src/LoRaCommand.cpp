@@ -0,0 +1,110 @@
+/*
+ *  LoRaCommand.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the LoRa command queue for the undocked RPU.
+ */
+
+#include "LoRaCommand.h"
+
+static void WriteLE32(uint8_t * field, uint32_t value)
+{
+    field[0] = (uint8_t) value;
+    field[1] = (uint8_t) (value >> 8);
+    field[2] = (uint8_t) (value >> 16);
+    field[3] = (uint8_t) (value >> 24);
+}
+
+static uint32_t ReadLE32(const uint8_t * field)
+{
+    return field[0] | ((uint32_t) field[1] << 8) | ((uint32_t) field[2] << 16) | ((uint32_t) field[3] << 24);
+}
+
+bool LoRaCommander::Queue(uint8_t msg_id, uint32_t param)
+{
+    LoRaCommand_t * slot = NULL;
+
+    for (uint8_t i = 0; i < LORA_CMD_SLOTS; i++) {
+        if (slots[i].tries > 0 && slots[i].msg_id == msg_id) {
+            slot = &slots[i];
+            break;
+        }
+        if (0 == slots[i].tries && NULL == slot) slot = &slots[i];
+    }
+
+    if (NULL == slot) return false;
+
+    // a new sequence, so a late ACK for the replaced command can't match
+    slot->msg_id = msg_id;
+    slot->param = param;
+    slot->seq = next_seq++;
+    slot->tries = 1;
+    slot->sent_ms = 0;
+    return true;
+}
+
+uint8_t LoRaCommander::NextPacket(uint32_t now_ms, uint8_t * packet)
+{
+    for (uint8_t i = 0; i < LORA_CMD_SLOTS; i++) {
+        LoRaCommand_t & command = slots[i];
+        if (0 == command.tries) continue;
+
+        // tries counts attempts plus one, so 1 = not yet sent
+        if (command.tries > 1 && now_ms - command.sent_ms < LORA_CMD_RETRY_MS) continue;
+
+        if (command.tries > LORA_CMD_TRIES) {
+            failed_id = command.msg_id;
+            failed_pending = true;
+            failed++;
+            command.tries = 0;
+            continue;
+        }
+
+        packet[0] = LORA_CMD_MAGIC_0;
+        packet[1] = LORA_CMD_MAGIC_1;
+        packet[2] = command.seq;
+        packet[3] = command.msg_id;
+        WriteLE32(packet + 4, command.param);
+        WriteLE32(packet + 8, crc->Compute(packet, 8));
+
+        command.tries++;
+        command.sent_ms = now_ms;
+        sent++;
+        return LORA_CMD_SIZE;
+    }
+
+    return 0;
+}
+
+LoRaCmdResult_t LoRaCommander::HandleAck(const uint8_t * packet, uint16_t length, uint8_t * msg_id)
+{
+    if (LORA_ACK_SIZE != length || LORA_CMD_MAGIC_0 != packet[0] || LORA_ACK_MAGIC_1 != packet[1]
+        || ReadLE32(packet + 5) != crc->Compute(packet, 5)) {
+        return LORA_CMD_NONE;
+    }
+
+    for (uint8_t i = 0; i < LORA_CMD_SLOTS; i++) {
+        LoRaCommand_t & command = slots[i];
+        if (command.tries > 1 && command.seq == packet[2] && command.msg_id == packet[3]) {
+            command.tries = 0;
+            *msg_id = command.msg_id;
+            if (packet[4]) {
+                acked++;
+                return LORA_CMD_ACKED;
+            }
+            failed++;
+            return LORA_CMD_NAKED;
+        }
+    }
+
+    return LORA_CMD_STALE;
+}
+
+bool LoRaCommander::TakeFailed(uint8_t * msg_id)
+{
+    if (!failed_pending) return false;
+
+    *msg_id = failed_id;
+    failed_pending = false;
+    return true;
+}
@@ -0,0 +1,78 @@
+/*
+ *  LoRaCommand.h
+ *  Created: October 2026
+ *
+ *  Commands to the undocked RPU over LoRa, with ACKs and retries (packet
+ *  format in LinkProtocol.h). Commands wait in a small table until the RPU
+ *  ACKs or NAKs them; each is sent at once and then resent every
+ *  LORA_CMD_RETRY_MS until LORA_CMD_TRIES attempts have gone unanswered.
+ *  Queueing a command with the same message id as one still waiting replaces
+ *  it, so only the latest setting is sent.
+ *
+ *  The class only builds and checks packets; the caller owns the radio.
+ */
+
+#ifndef LORACOMMAND_H
+#define LORACOMMAND_H
+
+#include "Arduino.h"
+#include "CRC32.h"
+#include "LinkProtocol.h"
+
+#define LORA_CMD_SLOTS      4
+#define LORA_CMD_TRIES      4
+#define LORA_CMD_RETRY_MS   5000
+
+struct LoRaCommand_t {
+    uint8_t msg_id;
+    uint8_t seq;
+    uint8_t tries;          // attempts + 1, so 0 = free slot and 1 = not yet sent
+    uint32_t param;
+    uint32_t sent_ms;
+};
+
+enum LoRaCmdResult_t : uint8_t {
+    LORA_CMD_NONE,          // not an ACK packet
+    LORA_CMD_STALE,         // a valid ACK for no waiting command
+    LORA_CMD_ACKED,
+    LORA_CMD_NAKED,
+};
+
+class LoRaCommander {
+public:
+    LoRaCommander(CRC32 * crc) : crc(crc) { };
+    ~LoRaCommander() { };
+
+    // Returns false if every slot holds a different waiting command
+    bool Queue(uint8_t msg_id, uint32_t param);
+
+    // Build the next packet that is due into packet (LORA_CMD_SIZE bytes) and
+    // return its length, or 0 if nothing is due
+    uint8_t NextPacket(uint32_t now_ms, uint8_t * packet);
+
+    // Match a received packet against the waiting commands; sets msg_id for
+    // ACKED and NAKED
+    LoRaCmdResult_t HandleAck(const uint8_t * packet, uint16_t length, uint8_t * msg_id);
+
+    // The last command dropped after LORA_CMD_TRIES unanswered attempts, once
+    bool TakeFailed(uint8_t * msg_id);
+
+    // Statistics since boot
+    uint32_t Sent() { return sent; }            // including resends
+    uint32_t Acked() { return acked; }
+    uint32_t Failed() { return failed; }        // NAKed or unanswered
+
+private:
+    CRC32 * crc;
+
+    LoRaCommand_t slots[LORA_CMD_SLOTS] = {};
+    uint8_t next_seq = 0;
+    uint8_t failed_id = 0;
+    bool failed_pending = false;
+
+    uint32_t sent = 0;
+    uint32_t acked = 0;
+    uint32_t failed = 0;
+};
+
+#endif /* LORACOMMAND_H */
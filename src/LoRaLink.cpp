@@ -0,0 +1,77 @@
+/*
+ *  LoRaLink.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the LoRa link statistics and rate choice.
+ */
+
+#include "LoRaLink.h"
+
+void LoRaLinkStats::Note(int16_t rssi, float snr, int32_t freq_error, bool in_window)
+{
+    if (0 == packets || snr < snr_min) snr_min = snr;
+
+    packets++;
+    rssi_sum += rssi;
+    snr_sum += snr;
+
+    uint32_t error = (freq_error < 0) ? -freq_error : freq_error;
+    if (error > freq_error_max) freq_error_max = error;
+
+    // saturate rather than wrap, these are only reported
+    uint16_t & rssi_bin = rssi_hist[Bin(rssi, LORA_RSSI_HIST_MIN, LORA_RSSI_HIST_STEP)];
+    uint16_t & snr_bin = snr_hist[Bin(snr, LORA_SNR_HIST_MIN, LORA_SNR_HIST_STEP)];
+    if (rssi_bin < UINT16_MAX) rssi_bin++;
+    if (snr_bin < UINT16_MAX) snr_bin++;
+
+    if (!in_window) return;
+
+    if (0 == window_packets || snr < window_snr_min) window_snr_min = snr;
+    if (window_packets < UINT16_MAX) window_packets++;
+}
+
+void LoRaLinkStats::ResetWindow()
+{
+    window_packets = 0;
+    window_snr_min = 0.0f;
+}
+
+uint8_t LoRaLinkStats::ChooseRate(const LoRaRate_t * rates, uint8_t count, uint8_t current)
+{
+    if (current >= count) return 0;
+
+    // not enough seen at these settings to judge either way
+    if (window_packets < LORA_ADR_MIN_PACKETS) return current;
+
+    const LoRaRate_t & measured = rates[current];
+
+    if (Margin(measured, measured, window_snr_min) < LORA_ADR_MARGIN_DB / 2) {
+        uint8_t rate = current;
+        while (rate > 0 && Margin(rates[rate], measured, window_snr_min) < LORA_ADR_MARGIN_DB) rate--;
+        return rate;
+    }
+
+    if (current + 1 < count && Margin(rates[current + 1], measured, window_snr_min) >= LORA_ADR_MARGIN_DB) {
+        return current + 1;
+    }
+
+    return current;
+}
+
+uint8_t LoRaLinkStats::Bin(float value, int16_t min, int16_t step)
+{
+    if (value < min) return 0;
+
+    int16_t bin = (int16_t) ((value - min) / step);
+    return (bin >= LORA_HIST_BINS) ? LORA_HIST_BINS - 1 : bin;
+}
+
+// SNR margin above the demodulation floor at a rate, from an SNR measured at
+// another; the SX127x reports SNR in the occupied bandwidth
+float LoRaLinkStats::Margin(const LoRaRate_t & rate, const LoRaRate_t & measured, float snr)
+{
+    float predicted = snr - 10.0f * log10f((float) rate.bandwidth / (float) measured.bandwidth);
+    float floor = 10.0f - 2.5f * rate.sf;
+
+    return predicted - floor;
+}
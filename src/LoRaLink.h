@@ -0,0 +1,85 @@
+/*
+ *  LoRaLink.h
+ *  Created: October 2026
+ *
+ *  Reception statistics for the RPU LoRa link, and the adaptive data rate
+ *  choice they drive (see LINK_LORA_RATE in LinkProtocol.h).
+ *
+ *  Every received packet's RSSI, SNR and frequency error is folded into
+ *  totals and coarse histograms since boot, for the RACHUTSREPORT. A separate
+ *  window, restarted whenever a profile rate is agreed, keeps the worst SNR
+ *  seen from the undocked RPU at that rate; ChooseRate() uses it to pick the
+ *  settings for the next profile.
+ *
+ *  The rate choice predicts the SNR at other settings from the window's worst
+ *  SNR (each doubling of bandwidth costs 3 dB) and compares it against the
+ *  demodulation floor of the spreading factor (-7.5 dB at SF7, 2.5 dB lower
+ *  per step). It moves up at most one step per profile, and only when the
+ *  margin holds at the faster settings; it drops as far as needed at once
+ *  when the margin at the current settings falls below half.
+ */
+
+#ifndef LORALINK_H
+#define LORALINK_H
+
+#include "Arduino.h"
+
+#define LORA_HIST_BINS          8
+#define LORA_RSSI_HIST_MIN      -140    // dBm, bins of LORA_RSSI_HIST_STEP
+#define LORA_RSSI_HIST_STEP     10
+#define LORA_SNR_HIST_MIN       -20     // dB, bins of LORA_SNR_HIST_STEP
+#define LORA_SNR_HIST_STEP      5
+
+#define LORA_ADR_MARGIN_DB      8.0f    // margin required to use a setting
+#define LORA_ADR_MIN_PACKETS    10      // window needed before stepping up
+
+struct LoRaRate_t {
+    uint8_t sf;             // spreading factor
+    uint32_t bandwidth;     // Hz
+};
+
+class LoRaLinkStats {
+public:
+    LoRaLinkStats() { };
+    ~LoRaLinkStats() { };
+
+    // Fold in one received packet; in_window when it counts towards the rate
+    // choice (the RPU is undocked, so at the agreed profile rate)
+    void Note(int16_t rssi, float snr, int32_t freq_error, bool in_window);
+
+    // Restart the rate window, when a new profile rate is agreed
+    void ResetWindow();
+
+    // Index into rates (ordered slowest first) to use for the next profile
+    uint8_t ChooseRate(const LoRaRate_t * rates, uint8_t count, uint8_t current);
+
+    // Statistics since boot
+    uint32_t Packets() { return packets; }
+    int16_t MeanRSSI() { return packets ? (int16_t) (rssi_sum / (int32_t) packets) : 0; }
+    float MeanSNR() { return packets ? snr_sum / packets : 0.0f; }
+    float MinSNR() { return snr_min; }
+    uint32_t MaxFreqError() { return freq_error_max; }  // Hz, absolute
+    const uint16_t * RSSIHistogram() { return rssi_hist; }
+    const uint16_t * SNRHistogram() { return snr_hist; }
+
+    // Rate window
+    uint16_t WindowPackets() { return window_packets; }
+    float WindowMinSNR() { return window_snr_min; }
+
+private:
+    static uint8_t Bin(float value, int16_t min, int16_t step);
+    static float Margin(const LoRaRate_t & rate, const LoRaRate_t & measured, float snr);
+
+    uint32_t packets = 0;
+    int32_t rssi_sum = 0;
+    float snr_sum = 0.0f;
+    float snr_min = 0.0f;
+    uint32_t freq_error_max = 0;
+    uint16_t rssi_hist[LORA_HIST_BINS] = {0};
+    uint16_t snr_hist[LORA_HIST_BINS] = {0};
+
+    uint16_t window_packets = 0;
+    float window_snr_min = 0.0f;
+};
+
+#endif /* LORALINK_H */
@@ -0,0 +1,65 @@
+/*
+ *  LoRaQueue.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the interrupt-safe LoRa packet queue.
+ */
+
+#include "LoRaQueue.h"
+
+// keeps the compiler from moving slot accesses across an index update; the
+// producer and consumer share one core, so no hardware barrier is needed
+#define QUEUE_BARRIER() asm volatile("" ::: "memory")
+
+void LoRaQueue::AssignSlots(LoRaPacket_t * slot_buffer)
+{
+    slots = slot_buffer;
+    head = 0;
+    tail = 0;
+}
+
+LoRaPacket_t * LoRaQueue::Reserve(int length)
+{
+    if (NULL == slots) return NULL;
+
+    if (length < 0 || length > LORA_MAX_PACKET) {
+        overflows++;
+        return NULL;
+    }
+
+    // indices run free and wrap at 256, a multiple of the depth
+    if ((uint8_t) (head - tail) >= LORA_QUEUE_DEPTH) {
+        dropped++;
+        return NULL;
+    }
+
+    LoRaPacket_t * packet = &slots[head % LORA_QUEUE_DEPTH];
+    packet->length = (uint8_t) length;
+    return packet;
+}
+
+void LoRaQueue::Commit()
+{
+    QUEUE_BARRIER();
+    head = head + 1;
+    received++;
+
+    uint8_t depth = head - tail;
+    if (depth > high_water) high_water = depth;
+}
+
+LoRaPacket_t * LoRaQueue::Front()
+{
+    if (NULL == slots || head == tail) return NULL;
+
+    QUEUE_BARRIER();
+    return &slots[tail % LORA_QUEUE_DEPTH];
+}
+
+void LoRaQueue::Pop()
+{
+    if (head == tail) return;
+
+    QUEUE_BARRIER();
+    tail = tail + 1;
+}
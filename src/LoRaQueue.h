@@ -0,0 +1,72 @@
+/*
+ *  LoRaQueue.h
+ *  Created: October 2026
+ *
+ *  A lock-free single-producer/single-consumer queue of received LoRa
+ *  packets. The LoRa library's onReceive() callback runs from the DIO0
+ *  interrupt; it copies each packet out of the radio FIFO into a free slot
+ *  (the producer), and LoRaRX() drains every queued packet once per loop (the
+ *  consumer). A burst of packets between loops is no longer overwritten in
+ *  the radio FIFO, and the main loop no longer depends on radio timing.
+ *
+ *  The producer only writes head and the consumer only writes tail, so no
+ *  locking is needed on a single core. Packets that arrive with the queue
+ *  full are dropped and counted, as are packets too long for a slot.
+ */
+
+#ifndef LORAQUEUE_H
+#define LORAQUEUE_H
+
+#include "Arduino.h"
+
+#define LORA_QUEUE_DEPTH    8       // power of two
+#define LORA_MAX_PACKET     255     // SX127x FIFO payload limit
+
+static_assert((LORA_QUEUE_DEPTH & (LORA_QUEUE_DEPTH - 1)) == 0 && LORA_QUEUE_DEPTH <= 128,
+              "LORA_QUEUE_DEPTH must be a power of two no larger than 128");
+
+struct LoRaPacket_t {
+    uint32_t rx_ms;                 // millis() at reception
+    int32_t freq_error;             // Hz, transmitter relative to receiver
+    float snr;                      // dB
+    int16_t rssi;                   // dBm
+    uint8_t length;
+    uint8_t data[LORA_MAX_PACKET];
+};
+
+class LoRaQueue {
+public:
+    LoRaQueue() { };
+    ~LoRaQueue() { };
+
+    // The slots must hold LORA_QUEUE_DEPTH packets; empties the queue
+    void AssignSlots(LoRaPacket_t * slot_buffer);
+
+    // Producer (interrupt): a slot for a packet of the given length, or NULL
+    // if the packet must be dropped. Commit() publishes the filled slot.
+    LoRaPacket_t * Reserve(int length);
+    void Commit();
+
+    // Consumer (main loop): the oldest packet, or NULL if empty. Pop() frees it.
+    LoRaPacket_t * Front();
+    void Pop();
+
+    // Statistics since boot
+    uint32_t Received() { return received; }
+    uint32_t Dropped() { return dropped; }     // queue full
+    uint32_t Overflows() { return overflows; } // longer than a slot
+    uint8_t HighWater() { return high_water; }
+
+private:
+    LoRaPacket_t * slots = NULL;
+
+    volatile uint8_t head = 0;      // next slot to fill, written by the producer
+    volatile uint8_t tail = 0;      // next slot to drain, written by the consumer
+
+    volatile uint32_t received = 0;
+    volatile uint32_t dropped = 0;
+    volatile uint32_t overflows = 0;
+    volatile uint8_t high_water = 0;
+};
+
+#endif /* LORAQUEUE_H */
@@ -0,0 +1,156 @@
+/*
+ *  LoRaRecords.cpp
+ *  Created: October 2026
+ *
+ *  This file implements LoRa profile record fragment reassembly.
+ */
+
+#include "LoRaRecords.h"
+
+void LoRaRecords::AssignBuffer(uint8_t * new_buffer, uint16_t size)
+{
+    if (new_buffer != buffer) {
+        DiscardStaged();
+        buffer = new_buffer;
+    }
+
+    buffer_size = (NULL == new_buffer) ? 0 : size;
+}
+
+LoRaFragResult_t LoRaRecords::Add(const uint8_t * packet, uint16_t length, uint32_t rx_ms)
+{
+    if (length < LORA_FRAG_HEADER_SIZE || LORA_FRAG_MAGIC_0 != packet[0] || LORA_FRAG_MAGIC_1 != packet[1]) {
+        return FRAG_NONE;
+    }
+
+    total_fragments++;
+
+    uint8_t frag_profile = packet[2];
+    uint8_t count = packet[3] & ~LORA_FRAG_LAST;
+    bool last = packet[3] & LORA_FRAG_LAST;
+    uint16_t seq = packet[4] | ((uint16_t) packet[5] << 8);
+    uint32_t check = packet[6] | ((uint32_t) packet[7] << 8) | ((uint32_t) packet[8] << 16) | ((uint32_t) packet[9] << 24);
+    uint16_t data_length = count * record_size;
+    uint16_t entry_length = LORA_FRAG_ENTRY_SIZE + data_length;
+
+    if (0 == count || seq >= LORA_FRAG_MAX_SEQ || length != LORA_FRAG_HEADER_SIZE + data_length
+        || check != crc->Compute(packet + LORA_FRAG_HEADER_SIZE, data_length)) {
+        total_bad++;
+        return FRAG_BAD;
+    }
+
+    if (NULL == buffer) return FRAG_NO_BUFFER;
+
+    // never fits, however empty the staging buffer
+    if (entry_length > buffer_size) {
+        total_bad++;
+        return FRAG_BAD;
+    }
+
+    // the staged fragments must go first if this one starts a new profile or
+    // doesn't fit; if they still haven't been sent since the last request, the
+    // TM isn't being serviced, so drop them rather than stall the queue
+    bool new_profile = !profile_valid || frag_profile != profile;
+    if ((new_profile && staged_fragments > 0) || staged_length + entry_length > buffer_size) {
+        if (!flush_requested) {
+            flush_requested = true;
+            return FRAG_FLUSH_FIRST;
+        }
+        DiscardStaged();
+    }
+
+    if (new_profile) StartProfile(frag_profile);
+
+    if (IsReceived(seq)) return FRAG_DUPLICATE;
+
+    if (0 == staged_fragments) staged_ms = rx_ms;
+
+    buffer[staged_length++] = (uint8_t) (seq & 0xFF);
+    buffer[staged_length++] = (uint8_t) (seq >> 8);
+    buffer[staged_length++] = count;
+    memcpy(buffer + staged_length, packet + LORA_FRAG_HEADER_SIZE, data_length);
+    staged_length += data_length;
+    staged_fragments++;
+    staged_records += count;
+
+    SetReceived(seq, true);
+    if (seq > highest) highest = seq;
+    if (last) last_staged = true;
+
+    return FRAG_ACCEPTED;
+}
+
+bool LoRaRecords::FlushDue(uint32_t now_ms, uint32_t max_age_ms)
+{
+    if (0 == staged_fragments) return false;
+
+    return flush_requested || last_staged || (now_ms - staged_ms >= max_age_ms);
+}
+
+void LoRaRecords::ClearStaged()
+{
+    staged_length = 0;
+    staged_fragments = 0;
+    staged_records = 0;
+    flush_requested = false;
+    last_staged = false;
+}
+
+uint16_t LoRaRecords::Missing()
+{
+    if (0 == received) return 0;
+
+    return highest + 1 - received;
+}
+
+bool LoRaRecords::NextRange(uint16_t * first, uint16_t * last)
+{
+    if (0 == received) return false;
+
+    uint16_t seq = *first;
+    while (seq <= highest && !IsReceived(seq)) seq++;
+    if (seq > highest) return false;
+
+    *first = seq;
+    while (seq < highest && IsReceived(seq + 1)) seq++;
+    *last = seq;
+
+    return true;
+}
+
+void LoRaRecords::StartProfile(uint8_t new_profile)
+{
+    profile = new_profile;
+    profile_valid = true;
+    received = 0;
+    highest = 0;
+    memset(seen, 0, sizeof(seen));
+}
+
+// the discarded fragments were never forwarded, so they count as missing again
+void LoRaRecords::DiscardStaged()
+{
+    uint16_t index = 0;
+
+    while (index + LORA_FRAG_ENTRY_SIZE <= staged_length) {
+        uint16_t seq = buffer[index] | ((uint16_t) buffer[index + 1] << 8);
+        SetReceived(seq, false);
+        index += LORA_FRAG_ENTRY_SIZE + buffer[index + 2] * record_size;
+    }
+
+    total_discarded += staged_fragments;
+    ClearStaged();
+}
+
+void LoRaRecords::SetReceived(uint16_t seq, bool value)
+{
+    if (IsReceived(seq) == value) return;
+
+    if (value) {
+        seen[seq >> 3] |= (1 << (seq & 7));
+        received++;
+    } else {
+        seen[seq >> 3] &= ~(1 << (seq & 7));
+        received--;
+    }
+}
@@ -0,0 +1,103 @@
+/*
+ *  LoRaRecords.h
+ *  Created: October 2026
+ *
+ *  Reassembly of the profile records an undocked RPU streams over LoRa (see
+ *  LINK_LORA_STREAM in LinkProtocol.h). Each accepted fragment is staged, with
+ *  its sequence number, in a buffer that the mode loop forwards as one TM:
+ *      [seq lo][seq hi][record count][records] ... per fragment
+ *  so the ground can place every record even when fragments arrive out of
+ *  order or are missing.
+ *
+ *  A bitmap of the fragments received for the current profile is kept so that
+ *  the ranges can be sent to the RPU before a dock offload (LINK_LORA_HAVE),
+ *  leaving only the missing records to come over the dock link. A fragment is
+ *  only marked received once it has been staged, and unmarked again if its
+ *  staged copy is ever discarded unsent.
+ */
+
+#ifndef LORARECORDS_H
+#define LORARECORDS_H
+
+#include "Arduino.h"
+#include "CRC32.h"
+#include "LinkProtocol.h"
+
+#define LORA_FRAG_ENTRY_SIZE    3       // staged seq (2) and record count (1)
+
+enum LoRaFragResult_t : uint8_t {
+    FRAG_NONE,          // not a record fragment, handle as an RPU status packet
+    FRAG_BAD,           // malformed or failed its CRC
+    FRAG_DUPLICATE,     // already received for this profile
+    FRAG_ACCEPTED,
+    FRAG_FLUSH_FIRST,   // staging full or a new profile: send the TM, then retry
+    FRAG_NO_BUFFER,     // no staging buffer in this phase, dropped
+};
+
+class LoRaRecords {
+public:
+    // record_size is RPU_RECORD_BYTES, the size of one profile record
+    LoRaRecords(CRC32 * crc, uint16_t record_size) : crc(crc), record_size(record_size) { };
+    ~LoRaRecords() { };
+
+    // Staging buffer, or NULL when there is none; discards anything staged
+    void AssignBuffer(uint8_t * buffer, uint16_t size);
+
+    // Check and stage one received LoRa packet
+    LoRaFragResult_t Add(const uint8_t * packet, uint16_t length, uint32_t rx_ms);
+
+    // True when the staged fragments should be sent: after the profile's last
+    // fragment, once the oldest has waited max_age_ms, or after FRAG_FLUSH_FIRST
+    bool FlushDue(uint32_t now_ms, uint32_t max_age_ms);
+
+    // The staged TM payload; ClearStaged() once it has been sent
+    const uint8_t * Staged() { return buffer; }
+    uint16_t StagedLength() { return staged_length; }
+    uint16_t StagedFragments() { return staged_fragments; }
+    uint16_t StagedRecords() { return staged_records; }
+    void ClearStaged();
+
+    // Fragments received for the current profile
+    uint8_t Profile() { return profile; }
+    uint16_t Received() { return received; }
+    uint16_t Missing();     // below the highest sequence received
+
+    // Runs of consecutive received fragments, in order: the run starting at or
+    // after *first. Returns false when there are no more.
+    bool NextRange(uint16_t * first, uint16_t * last);
+
+    // Statistics since boot
+    uint32_t Fragments() { return total_fragments; }
+    uint32_t Bad() { return total_bad; }
+    uint32_t Discarded() { return total_discarded; }    // staged, never sent
+
+private:
+    void StartProfile(uint8_t new_profile);
+    void DiscardStaged();
+    bool IsReceived(uint16_t seq) { return seen[seq >> 3] & (1 << (seq & 7)); }
+    void SetReceived(uint16_t seq, bool value);
+
+    CRC32 * crc;
+    uint16_t record_size;
+
+    uint8_t * buffer = NULL;
+    uint16_t buffer_size = 0;
+    uint16_t staged_length = 0;
+    uint16_t staged_fragments = 0;
+    uint16_t staged_records = 0;
+    uint32_t staged_ms = 0;         // rx time of the oldest staged fragment
+    bool flush_requested = false;   // FRAG_FLUSH_FIRST returned, not yet sent
+    bool last_staged = false;       // the profile's final fragment is staged
+
+    uint8_t profile = 0;
+    bool profile_valid = false;
+    uint16_t received = 0;
+    uint16_t highest = 0;           // highest sequence received
+    uint8_t seen[LORA_FRAG_MAX_SEQ / 8] = {0};
+
+    uint32_t total_fragments = 0;
+    uint32_t total_bad = 0;
+    uint32_t total_discarded = 0;
+};
+
+#endif /* LORARECORDS_H */
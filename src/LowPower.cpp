@@ -25,6 +25,7 @@ void StratoRachuts::LowPowerMode()
 {
     mode_code = "LP";
     SendPeriodicRACHUTSREPORT();
+    SendLoRaRecordTM(false);
     switch (inst_substate) {
     case LP_ENTRY:
         // perform setup
@@ -39,7 +40,7 @@ void StratoRachuts::LowPowerMode()
         inst_substate = LP_CHECK_MCB;
         break;
     case LP_CHECK_MCB:
-        log_debug("Waiting on MCB LP ack");
+        LOG_DEBUG("Waiting on MCB LP ack");
         if (mcb_low_power) {
             mcb_low_power = false;
             inst_substate = LP_LOOP;
@@ -49,10 +50,10 @@ void StratoRachuts::LowPowerMode()
         break;
     case LP_LOOP:
         // nominal ops
-        log_debug("LP loop");
+        LOG_DEBUG("LP loop");
         break;
     case LP_ERROR_LANDING:
-        log_debug("LP error");
+        LOG_DEBUG("LP error");
         break;
     case LP_SHUTDOWN:
         // prep for shutdown
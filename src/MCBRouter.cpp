@@ -11,22 +11,69 @@
 
 void StratoRachuts::RunMCBRouter()
 {
-    SerialMessage_t rx_msg = mcbComm.RX();
+    // as for the PU, only hand mcbComm complete frames (see RunPURouter)
+    mcbSeq.Expire(millis(), MCB_RESEND_TIMEOUT * 1000UL);
+
+    while (mcbFramer.Poll()) {
+        SerialMessage_t rx_msg = mcbComm.RX();
+
+        if (NO_MESSAGE == rx_msg) {
+            log_error("MCB frame rejected by MCBComm");
+            continue;
+        }
+
+        if (!AcceptMCBReply(rx_msg)) continue;
 
-    while (NO_MESSAGE != rx_msg) {
         if (ASCII_MESSAGE == rx_msg) {
+            eventTrace.Record(TRACE_MCB_RX, rx_msg, mcbComm.ascii_rx.msg_id);
             HandleMCBASCII();
         } else if (ACK_MESSAGE == rx_msg) {
+            eventTrace.Record(TRACE_MCB_RX, rx_msg, mcbComm.ack_id);
             HandleMCBAck();
         } else if (BIN_MESSAGE == rx_msg) {
+            eventTrace.Record(TRACE_MCB_RX, rx_msg, mcbComm.binary_rx.bin_id);
             HandleMCBBin();
         } else if (STRING_MESSAGE == rx_msg) {
+            eventTrace.Record(TRACE_MCB_RX, rx_msg, mcbComm.string_rx.str_id);
             HandleMCBString();
         } else {
             log_error("Unknown message type from MCB");
         }
+    }
+
+    ReportResync("MCB", mcbFramer, mcb_discard_reported);
+}
 
-        rx_msg = mcbComm.RX();
+void StratoRachuts::TagMCBRequest(uint8_t request_id)
+{
+    if (!pibConfigs.mcb_seq_tags.Read()) return;
+
+    mcbFramer.TX_Tag(mcbSeq.Open(request_id, millis()));
+}
+
+bool StratoRachuts::AcceptMCBReply(SerialMessage_t rx_msg)
+{
+    uint8_t seq = 0;
+
+    // only command acks are solicited; motion TMs and faults are always handled
+    if (ACK_MESSAGE != rx_msg || !mcbFramer.FrameTag(&seq)) return true;
+
+    switch (mcbSeq.Match(seq, mcbComm.ack_id)) {
+    case SEQ_DUPLICATE:
+        snprintf(log_array, LOG_ARRAY_SIZE, "MCB duplicate ack dropped (seq %u, id %u)", seq, mcbComm.ack_id);
+        log_error(log_array);
+        return false;
+    case SEQ_LATE:
+        snprintf(log_array, LOG_ARRAY_SIZE, "MCB late ack dropped (seq %u, id %u)", seq, mcbComm.ack_id);
+        log_error(log_array);
+        return false;
+    case SEQ_MISMATCHED:
+    case SEQ_UNSOLICITED:
+        LOG_DEBUG("MCB unexpected tagged ack (seq %u, id %u)", seq, mcbComm.ack_id);
+        return true;
+    case SEQ_MATCHED:
+    default:
+        return true;
     }
 }
 
@@ -139,12 +186,17 @@ void StratoRachuts::HandleMCBAck()
 void StratoRachuts::HandleMCBBin()
 {
     // reel_pos is a member (used in SendMCBTM StateMess3); update it here.
-    uint16_t reel_pos_index = 21; // todo: don't hard-code this
+    uint16_t reel_pos_index = MOTION_TM_REEL_POS_INDEX;
+    float new_reel_pos = 0.0f;
 
     switch (mcbComm.binary_rx.bin_id) {
     case MCB_MOTION_TM:
-        if (BufferGetFloat(&reel_pos, mcbComm.binary_rx.bin_buffer, mcbComm.binary_rx.bin_length, &reel_pos_index)) {
-            snprintf(log_array, 101, "Reel position: %ld", (int32_t) reel_pos);
+        // the bytes are only checksummed, so a position that isn't a plausible
+        // number leaves the last good one in place
+        if (BufferGetFloat(&new_reel_pos, mcbComm.binary_rx.bin_buffer, mcbComm.binary_rx.bin_length, &reel_pos_index)
+            && isfinite(new_reel_pos) && fabsf(new_reel_pos) < REEL_POS_LIMIT) {
+            reel_pos = new_reel_pos;
+            snprintf(log_array, LOG_ARRAY_SIZE, "Reel position: %ld", (long) reel_pos);
             log_nominal(log_array);
         } else {
             log_nominal("Recieved MCB bin: unable to read position");
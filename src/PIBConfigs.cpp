@@ -39,6 +39,17 @@ PIBConfigs::PIBConfigs()
     , lora_tx_status(1800)
     , profile_id(1)
     , ra_override(false)
+    , pu_seq_tags(false)
+    , mcb_seq_tags(false)
+    , pu_record_fec(false)
+    , pu_fast_baud(115200)
+    , pu_adaptive_batch(false)
+    , pu_block_crc(false)
+    , lora_adr(false)
+    , lora_commands(false)
+    , downlink_cap(0)
+    , downlink_cap_report(0)
+    , downlink_cap_mcb(0)
     // ----------------------------------------------------
 { }
 
@@ -73,6 +84,17 @@ void PIBConfigs::RegisterAll()
     success &= Register(&lora_tx_status);
     success &= Register(&profile_id);
     success &= Register(&ra_override);
+    success &= Register(&pu_seq_tags);
+    success &= Register(&mcb_seq_tags);
+    success &= Register(&pu_record_fec);
+    success &= Register(&pu_fast_baud);
+    success &= Register(&pu_adaptive_batch);
+    success &= Register(&pu_block_crc);
+    success &= Register(&lora_adr);
+    success &= Register(&lora_commands);
+    success &= Register(&downlink_cap);
+    success &= Register(&downlink_cap_report);
+    success &= Register(&downlink_cap_mcb);
 
     if (!success) {
         debug_serial->println("Error registering EEPROM configs");
@@ -25,7 +25,7 @@ public:
     PIBConfigs();
 
     // constants, manually change version number here to force update
-    static const uint16_t CONFIG_VERSION = 0x5C07;
+    static const uint16_t CONFIG_VERSION = 0x5C0F;
     static const uint16_t BASE_ADDRESS = 0x0000;
 
     // ------------------ Configurations ------------------
@@ -67,12 +67,40 @@ public:
     EEPROMData<bool> real_time_mcb;
 
     // LoRa Settings
-    EEPROMData<bool> lora_tx_tm;
+    EEPROMData<bool> lora_tx_tm;    // RPU streams profile records over LoRa (LINK_LORA_STREAM)
     EEPROMData<uint16_t> lora_tx_status;
     
     EEPROMData<uint16_t> profile_id;
     EEPROMData<bool> ra_override;
 
+    // Link sequence tagging (peer firmware must support LINK_SEQ_TAG)
+    EEPROMData<bool> pu_seq_tags;
+    EEPROMData<bool> mcb_seq_tags;
+
+    // Decode FEC-coded profile records (RPU must send them, see LinkProtocol.h)
+    EEPROMData<bool> pu_record_fec;
+
+    // Dock-link baud rate to negotiate before an offload (115200 = don't)
+    EEPROMData<uint32_t> pu_fast_baud;
+
+    // Request an adaptive batch size with RPU_SEND_RECORDS (RPU must support it)
+    EEPROMData<bool> pu_adaptive_batch;
+
+    // Check CRC-carrying profile records and re-request damaged sub-blocks
+    EEPROMData<bool> pu_block_crc;
+
+    // Negotiate faster LoRa settings per profile from the link margin (RPU must support LINK_LORA_RATE)
+    EEPROMData<bool> lora_adr;
+
+    // Route RPU TCs over LoRa while the RPU is undocked (RPU must accept LoRa commands)
+    EEPROMData<bool> lora_commands;
+
+    // Zephyr bytes per rolling 24 h before periodic reports wait and real-time
+    // MCB TMs are decimated: in total, and for each of those (0 = no cap)
+    EEPROMData<uint32_t> downlink_cap;
+    EEPROMData<uint32_t> downlink_cap_report;
+    EEPROMData<uint32_t> downlink_cap_mcb;
+
     // ----------------------------------------------------
 
 };
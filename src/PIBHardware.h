@@ -17,6 +17,9 @@
 #define PU_SERIAL       Serial2
 #define RS41_SERIAL   Serial6
 
+// Receive PU_SERIAL by eDMA (SerialDMA.h) rather than the core RX interrupt
+//#define PU_SERIAL_DMA
+
 // Digital Pins
 #define PU_PWR_ENABLE   2
 #define FORCEON_232     41 //Unused on MonDo and Rev E
@@ -10,23 +10,127 @@
 
 void StratoRachuts::RunPURouter()
 {
-    SerialMessage_t rx_msg = puComm.RX();
+    // The framer only reports a frame once every byte of it has arrived, so
+    // puComm.RX() parses it from memory instead of busy-waiting on the dock
+    // link. Partial frames carry over to the next loop.
+    puSeq.Expire(millis(), PU_RESEND_TIMEOUT * 1000UL);
+
+    while (puFramer.Poll()) {
+        SerialMessage_t rx_msg = NO_MESSAGE;
+        uint8_t bin_id = 0;
+        uint16_t bin_length = 0;
+        bool checksum_valid = false;
+        bool in_place = false;
+
+        // Profile records are used where they sit in the frame buffer instead
+        // of being copied byte by byte into binary_pu by puComm.RX(); the
+        // binary_rx fields the handlers read are filled in to match. One
+        // larger than PU_BUFFER_SIZE can't go into a TM, so it is NAKed here
+        // rather than decoded or handed to puComm.RX().
+        if (puFramer.BinaryFrame(&bin_id, &pu_frame_payload, &bin_length, &checksum_valid)
+            && RPU_PROFILE_RECORD == bin_id) {
+            if (bin_length > PU_BUFFER_SIZE) {
+                snprintf(log_array, LOG_ARRAY_SIZE, "Profile record too large (len=%u)", bin_length);
+                log_error(log_array);
+                NotePUFrame(false);
+                puComm.TX_Ack(RPU_PROFILE_RECORD, false);
+                continue;
+            }
+            puComm.binary_rx.bin_id = bin_id;
+            puComm.binary_rx.bin_length = bin_length;
+            puComm.binary_rx.checksum_valid = checksum_valid;
+            rx_msg = BIN_MESSAGE;
+            in_place = true;
+        } else {
+            rx_msg = puComm.RX();
+        }
+
+        if (NO_MESSAGE == rx_msg) {
+            log_error("PU frame rejected by RPUComm");
+            NotePUFrame(false);
+            continue;
+        }
 
-    while (NO_MESSAGE != rx_msg) {
         PUDock();
+        NotePUFrame(BIN_MESSAGE != rx_msg || puComm.binary_rx.checksum_valid);
+        if (!AcceptPUReply(rx_msg)) continue;
+
         if (ASCII_MESSAGE == rx_msg) {
+            eventTrace.Record(TRACE_PU_RX, rx_msg, puComm.ascii_rx.msg_id);
             HandlePUASCII();
         } else if (ACK_MESSAGE == rx_msg) {
+            eventTrace.Record(TRACE_PU_RX, rx_msg, puComm.ack_id);
             HandlePUAck();
         } else if (BIN_MESSAGE == rx_msg) {
+            eventTrace.Record(TRACE_PU_RX, rx_msg, puComm.binary_rx.bin_id);
             HandlePUBin();
         } else if (STRING_MESSAGE == rx_msg) {
+            eventTrace.Record(TRACE_PU_RX, rx_msg, puComm.string_rx.str_id);
             HandlePUString();
         } else {
             log_error("Unknown message type from PU");
         }
 
-        rx_msg = puComm.RX();
+        // a record is only valid until the next Poll(), and Flight_PUOffload
+        // reads it later in this loop
+        if (in_place) break;
+    }
+
+    ReportResync("PU", puFramer, pu_discard_reported);
+}
+
+void StratoRachuts::TagPURequest(uint8_t request_id)
+{
+    if (!pibConfigs.pu_seq_tags.Read()) return;
+
+    puFramer.TX_Tag(puSeq.Open(request_id, millis()));
+}
+
+bool StratoRachuts::AcceptPUReply(SerialMessage_t rx_msg)
+{
+    uint8_t seq = 0;
+    uint8_t request_id = 0;
+
+    // untagged replies come from a legacy RPU and are always handled
+    if (!puFramer.FrameTag(&seq)) return true;
+
+    // map the reply to the request that solicited it
+    switch (rx_msg) {
+    case ACK_MESSAGE:
+        request_id = puComm.ack_id;
+        break;
+    case ASCII_MESSAGE:
+        request_id = (RPU_NO_MORE_RECORDS == puComm.ascii_rx.msg_id) ? RPU_SEND_RECORDS : puComm.ascii_rx.msg_id;
+        break;
+    case BIN_MESSAGE:
+        if (RPU_STATUS == puComm.binary_rx.bin_id) {
+            request_id = RPU_SEND_STATUS;
+        } else if (RPU_PROFILE_RECORD == puComm.binary_rx.bin_id) {
+            request_id = RPU_SEND_RECORDS;
+        } else {
+            request_id = puComm.binary_rx.bin_id;
+        }
+        break;
+    default:
+        return true;
+    }
+
+    switch (puSeq.Match(seq, request_id)) {
+    case SEQ_DUPLICATE:
+        snprintf(log_array, LOG_ARRAY_SIZE, "PU duplicate reply dropped (seq %u, id %u)", seq, request_id);
+        log_error(log_array);
+        return false;
+    case SEQ_LATE:
+        snprintf(log_array, LOG_ARRAY_SIZE, "PU late reply dropped (seq %u, id %u)", seq, request_id);
+        log_error(log_array);
+        return false;
+    case SEQ_MISMATCHED:
+    case SEQ_UNSOLICITED:
+        LOG_DEBUG("PU unexpected tagged reply (seq %u, id %u)", seq, request_id);
+        return true;
+    case SEQ_MATCHED:
+    default:
+        return true;
     }
 }
 
@@ -50,22 +154,42 @@ void StratoRachuts::HandlePUAck()
             log_nominal("RPU in measure");
             pu_measure = true;
         } else {
-            SendTextTM("RPU NAKed go-measure command", WARN);
+            SendTextTM(TXT_RPU_NAK_GO_MEASURE, WARN);
         }
         break;
     case RPU_GO_STANDBY:
         if (puComm.ack_value) {
             log_nominal("RPU in standby");
         } else {
-            SendTextTM("RPU NAKed go-standby command", WARN);
+            SendTextTM(TXT_RPU_NAK_GO_STANDBY, WARN);
         }
         break;
     case RPU_RESET:
-        SendTextTM("RPU acked reset", FINE);
+        SendTextTM(TXT_RPU_ACK_RESET, FINE);
         break;
     case RPU_SET_STATUS_RATE:
         log_nominal("RPU acked status rate");
         break;
+    case LINK_SET_BAUD:
+        if (puComm.ack_value) {
+            pu_baud_acked = true;
+        } else {
+            pu_baud_naked = true;
+        }
+        break;
+    case LINK_LORA_STREAM:
+        log_nominal(puComm.ack_value ? "RPU will stream records over LoRa" : "RPU NAKed LoRa record streaming");
+        break;
+    case LINK_LORA_HAVE:
+        break; // advisory
+    case LINK_LORA_RATE:
+        if (puComm.ack_value) {
+            AgreeLoRaRate(lora_rate_pending);
+        } else {
+            log_nominal("RPU NAKed LoRa rate, staying at base rate");
+            AgreeLoRaRate(0);
+        }
+        break;
     default:
         log_error("Unknown RPU ack received");
         break;
@@ -77,43 +201,18 @@ void StratoRachuts::HandlePUBin()
     // can handle all PU TM receipt here with ACKs/NAKs and tm_finished + buffer_ready flags
     switch (puComm.binary_rx.bin_id) {
     case RPU_PROFILE_RECORD:
-        if (!puComm.binary_rx.checksum_valid) {
-            // Send it anyway rather than NAK/retry: a checksum failure here is
-            // usually a few corrupted bytes, not total garbage, and retries often
-            // fail too (dock-link corruption, KnownIssues.md #1), previously
-            // aborting the whole offload after two failures in a row. ACKing (below)
-            // is required even though the checksum is bad -- a NAK would leave this
-            // batch un-popped on the RPU, which would just resend the same bytes
-            // forever while RACHUTS moves on to "new" (but identical) requests.
-            snprintf(log_array, LOG_ARRAY_SIZE, "Profile record checksum invalid (len=%u), sending to ground anyway",
-                     puComm.binary_rx.bin_length);
-            log_error(log_array);
-        }
-        if (!zephyrTX.addTm(puComm.binary_rx.bin_buffer, puComm.binary_rx.bin_length)) {
-            snprintf(log_array, LOG_ARRAY_SIZE, "Profile record too large for TM buffer (len=%u, tm_used=%u)",
-                     puComm.binary_rx.bin_length, zephyrTX.getTmLen());
-            log_error(log_array);
-            puComm.TX_Ack(RPU_PROFILE_RECORD, false);
-            zephyrTX.clearTm();
-        } else {
-            record_received = true;
-            puComm.TX_Ack(RPU_PROFILE_RECORD, true);
-        }
+        HandlePURecord();
         break;
 
     case RPU_STATUS: {
-        char json_buf[512];
+        char json_buf[RPU_STATUS_TEXT_IN];
         if (puComm.binary_rx.checksum_valid && puComm.RX_Status(json_buf, sizeof(json_buf))) {
-            pu_status_json = json_buf;
+            json_buf[sizeof(json_buf) - 1] = '\0';
+            if (!rpuStatus.Capture(RPU_SRC_DOCK, json_buf, millis(), now())) {
+                log_error("PU status not captured");
+            }
             pu_last_status = now();
             pu_status_received = true;
-            latest_rpu_json = json_buf;
-            latest_rpu_src = "DOCK";
-            last_rpu_recv_ms = millis();
-            rpu_ever_received = true;
-            rpu_status_pending = true;
-        } else {
-            pu_status_json = "";
         }
         break;
     }
@@ -124,6 +223,265 @@ void StratoRachuts::HandlePUBin()
     }
 }
 
+void StratoRachuts::HandlePURecord()
+{
+    uint16_t record_offset = 0;
+    uint16_t record_length = puComm.binary_rx.bin_length;
+    bool record_valid = puComm.binary_rx.checksum_valid;
+
+    if (0 != crc_repair_mask) {
+        // the reply to a sub-block re-request; the block itself is held in the
+        // frame buffer behind it
+        RecordCheck_t check = ApplyRecordRepair(pu_frame_payload);
+        if (RECORD_REPAIRING == check) return;
+        record_offset = crc_data_offset;
+        record_length = crc_data_length;
+        record_valid = (RECORD_OK == check);
+    } else {
+        pu_record = pu_frame_payload;
+
+        // an FEC-coded record is repaired here, so a frame with a bad checksum
+        // is usually recovered in full
+        if (pibConfigs.pu_record_fec.Read() && record_length >= FEC_HEADER_SIZE
+            && FEC_MAGIC_0 == pu_record[0] && FEC_MAGIC_1 == pu_record[1]) {
+            record_valid = DecodeFECRecord(&record_length);
+            if (!record_valid) {
+                snprintf(log_array, LOG_ARRAY_SIZE, "FEC record not fully recovered (len=%u, uncorrectable=%lu)",
+                         puComm.binary_rx.bin_length, (unsigned long) fec_uncorrectable);
+                log_error(log_array);
+            }
+        }
+
+        // the end-to-end CRC overrides the link checksum and FEC verdicts, and
+        // damaged sub-blocks are re-requested before the record is ACKed
+        if (pibConfigs.pu_block_crc.Read() && record_length >= CRC_HEADER_SIZE(1)
+            && CRC_MAGIC_0 == pu_record[0] && CRC_MAGIC_1 == pu_record[1]) {
+            RecordCheck_t check = CheckRecordCRC(&record_offset, &record_length);
+            if (RECORD_REPAIRING == check) return;
+            record_valid = (RECORD_OK == check);
+        }
+    }
+
+    if (!record_valid) {
+        puBatch.NoteCorrupt();
+        // Send it anyway rather than NAK/retry: a checksum failure here is
+        // usually a few corrupted bytes, not total garbage, and retries often
+        // fail too (dock-link corruption, KnownIssues.md #1), previously
+        // aborting the whole offload after two failures in a row. ACKing (below)
+        // is required even though the checksum is bad -- a NAK would leave this
+        // batch un-popped on the RPU, which would just resend the same bytes
+        // forever while RACHUTS moves on to "new" (but identical) requests.
+        // The RPUREPORT is flagged WARN so the ground knows.
+        snprintf(log_array, LOG_ARRAY_SIZE, "Profile record invalid (len=%u), sending to ground anyway",
+                 record_length);
+        log_error(log_array);
+    }
+
+    pu_record_offset = record_offset;
+    pu_record_length = record_length;
+    pu_record_valid = record_valid;
+
+    if (!zephyrTX.addTm(pu_record + record_offset, record_length)) {
+        snprintf(log_array, LOG_ARRAY_SIZE, "Profile record too large for TM buffer (len=%u, tm_used=%u)",
+                 record_length, zephyrTX.getTmLen());
+        log_error(log_array);
+        puComm.TX_Ack(RPU_PROFILE_RECORD, false);
+        zephyrTX.clearTm();
+    } else {
+        record_received = true;
+        puBatch.Received(record_length / RPU_RECORD_BYTES, millis());
+        puComm.TX_Ack(RPU_PROFILE_RECORD, true);
+    }
+}
+
+RecordCheck_t StratoRachuts::CheckRecordCRC(uint16_t * record_offset, uint16_t * record_length)
+{
+    uint16_t payload_length = *record_length;
+    uint8_t num_sub = pu_record[3];
+    uint16_t sub_size = pu_record[4] | ((uint16_t) pu_record[5] << 8);
+    uint16_t data_length = pu_record[6] | ((uint16_t) pu_record[7] << 8);
+    uint16_t header_length = CRC_HEADER_SIZE(num_sub);
+    uint32_t bad_mask = 0;
+    uint16_t repair_bytes = 0;
+
+    crc_records++;
+
+    // an inconsistent header means the block can't be checked at all
+    if (0 == num_sub || num_sub > CRC_MAX_SUBBLOCKS || (pu_record[2] & CRC_FLAG_PARTIAL)
+        || 0 == sub_size || (uint32_t) sub_size * num_sub < data_length
+        || (uint32_t) header_length + data_length != payload_length) {
+        crc_failed++;
+        return RECORD_CORRUPT;
+    }
+
+    *record_offset = header_length;
+    *record_length = data_length;
+
+    if (blockCRC.Compute(pu_record + header_length, data_length) == ReadCRC(pu_record + CRC_WHOLE_OFFSET)) {
+        return RECORD_OK;
+    }
+
+    for (uint8_t n = 0; n < num_sub; n++) {
+        uint16_t start = n * sub_size;
+        if (start >= data_length) break;
+        uint16_t count = (data_length - start < sub_size) ? data_length - start : sub_size;
+        if (blockCRC.Compute(pu_record + header_length + start, count) != ReadCRC(pu_record + CRC_SUB_OFFSET(n))) {
+            bad_mask |= (1UL << n);
+            repair_bytes += count;
+        }
+    }
+
+    // every sub-block checks out, so it was the whole-block CRC that was hit
+    if (0 == bad_mask) return RECORD_OK;
+
+    crc_bad_blocks++;
+
+    // the reply wouldn't fit behind the held block; forward it flagged
+    if ((uint32_t) header_length + repair_bytes > PU_PATCH_SIZE) {
+        crc_failed++;
+        return RECORD_CORRUPT;
+    }
+
+    crc_repair_mask = bad_mask;
+    crc_repair_tries = 0;
+    crc_data_offset = header_length;
+    crc_data_length = data_length;
+    puFramer.Hold();
+    RequestRecordRepair();
+
+    snprintf(log_array, LOG_ARRAY_SIZE, "Record CRC failed, re-requesting sub-blocks 0x%08lx (%u bytes)",
+             (unsigned long) bad_mask, repair_bytes);
+    log_nominal(log_array);
+
+    return RECORD_REPAIRING;
+}
+
+RecordCheck_t StratoRachuts::ApplyRecordRepair(const uint8_t * patch)
+{
+    uint16_t patch_length = puComm.binary_rx.bin_length;
+    uint8_t num_sub = pu_record[3];
+    uint16_t sub_size = pu_record[4] | ((uint16_t) pu_record[5] << 8);
+    uint16_t header_length = CRC_HEADER_SIZE(num_sub);
+    uint32_t present = 0;
+    uint16_t position = header_length;
+
+    // the partial reply repeats the original header, with only the re-sent
+    // sub-blocks present
+    if (patch_length >= header_length && CRC_MAGIC_0 == patch[0] && CRC_MAGIC_1 == patch[1]
+        && (patch[2] & CRC_FLAG_PARTIAL) && 0 == memcmp(patch + 3, pu_record + 3, 5)) {
+        present = patch[8] | ((uint32_t) patch[9] << 8) | ((uint32_t) patch[10] << 16) | ((uint32_t) patch[11] << 24);
+    }
+
+    for (uint8_t n = 0; n < num_sub && 0 != present; n++) {
+        if (!(present & (1UL << n))) continue;
+
+        uint16_t start = n * sub_size;
+        if (start >= crc_data_length) break;
+        uint16_t count = (crc_data_length - start < sub_size) ? crc_data_length - start : sub_size;
+        if (position + count > patch_length) break;
+
+        // only accept a sub-block that matches the CRC sent with the original
+        if ((crc_repair_mask & (1UL << n))
+            && blockCRC.Compute(patch + position, count) == ReadCRC(pu_record + CRC_SUB_OFFSET(n))) {
+            memcpy(pu_record + crc_data_offset + start, patch + position, count);
+            crc_repair_mask &= ~(1UL << n);
+            crc_repaired++;
+        }
+        position += count;
+    }
+
+    if (0 != crc_repair_mask && crc_repair_tries < CRC_MAX_REPAIRS) {
+        RequestRecordRepair();
+        return RECORD_REPAIRING;
+    }
+
+    bool repaired = (0 == crc_repair_mask);
+    CancelRecordRepair();
+
+    if (!repaired) crc_failed++;
+    return repaired ? RECORD_OK : RECORD_CORRUPT;
+}
+
+void StratoRachuts::RequestRecordRepair()
+{
+    puFramer.TX_Command(LINK_RESEND_SUB, crc_repair_mask);
+    crc_repair_tries++;
+}
+
+void StratoRachuts::CancelRecordRepair()
+{
+    crc_repair_mask = 0;
+    puFramer.ReleaseHeld();
+}
+
+uint32_t StratoRachuts::ReadCRC(const uint8_t * field)
+{
+    return field[0] | ((uint32_t) field[1] << 8) | ((uint32_t) field[2] << 16) | ((uint32_t) field[3] << 24);
+}
+
+bool StratoRachuts::DecodeFECRecord(uint16_t * record_length)
+{
+    uint16_t payload_length = puComm.binary_rx.bin_length;
+    uint8_t nsym = pu_record[3];
+    uint8_t depth = pu_record[4];
+    uint16_t data_length = pu_record[6] | ((uint16_t) pu_record[7] << 8);
+    const uint8_t * coded = pu_record + FEC_HEADER_SIZE;
+    uint8_t * fec_group = bufferArena.Lease(LEASE_FEC_GROUP);
+    uint16_t decoded = 0;
+    bool success = true;
+
+    // a corrupt header can't be decoded, so pass the frame on as received
+    *record_length = payload_length;
+
+    if (NULL == fec_group) return false;
+
+    if (FEC_VERSION != pu_record[2] || nsym < 2 || nsym > RS_MAX_PARITY || (nsym & 1)
+        || 0 == depth || depth > FEC_MAX_DEPTH) {
+        return false;
+    }
+
+    uint16_t codeword_data = FEC_CODEWORD_DATA(nsym);
+    uint16_t codewords = (data_length + codeword_data - 1) / codeword_data;
+    if ((uint32_t) FEC_HEADER_SIZE + (uint32_t) codewords * RS_BLOCK_SIZE != payload_length) {
+        return false;
+    }
+
+    fec_records++;
+
+    for (uint16_t first = 0; first < codewords; first += depth) {
+        uint8_t group = (codewords - first < depth) ? codewords - first : depth;
+
+        // de-interleave: symbol j of codeword k was sent at j * group + k
+        for (uint16_t j = 0; j < RS_BLOCK_SIZE; j++) {
+            for (uint8_t k = 0; k < group; k++) {
+                fec_group[k * RS_BLOCK_SIZE + j] = coded[j * group + k];
+            }
+        }
+        coded += group * RS_BLOCK_SIZE;
+
+        // Correct each codeword and compact its data to the front of the
+        // buffer. The write position never passes the start of the next group,
+        // and this group has already been copied out, so decoding is in place.
+        for (uint8_t k = 0; k < group; k++) {
+            uint8_t * codeword = fec_group + k * RS_BLOCK_SIZE;
+            int result = recordFEC.Decode(codeword, RS_BLOCK_SIZE, nsym);
+            if (result < 0) {
+                fec_uncorrectable++;
+                success = false;
+            } else {
+                fec_corrected += result;
+            }
+
+            uint16_t count = (data_length - decoded < codeword_data) ? data_length - decoded : codeword_data;
+            memcpy(pu_record + decoded, codeword, count);
+            decoded += count;
+        }
+    }
+
+    *record_length = data_length;
+    return success;
+}
+
 void StratoRachuts::HandlePUString()
 {
     switch (puComm.string_rx.str_id) {
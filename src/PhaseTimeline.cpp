@@ -0,0 +1,88 @@
+/*
+ *  PhaseTimeline.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the flight state-machine timeline.
+ */
+
+#include "PhaseTimeline.h"
+
+void PhaseTimeline::Start(TimelineMachine_t machine, uint32_t now_ms)
+{
+    top = machine;
+    active = true;
+    count = 0;
+    dropped = 0;
+    start_ms = now_ms;
+    elapsed_ms = 0;
+
+    for (uint8_t i = 0; i < TL_NUM_MACHINES; i++) seen[i] = false;
+}
+
+void PhaseTimeline::Note(TimelineMachine_t machine, uint8_t state, uint32_t now_ms)
+{
+    if (!active || machine >= TL_NUM_MACHINES) return;
+    if (seen[machine] && last_state[machine] == state) return;
+
+    seen[machine] = true;
+    last_state[machine] = state;
+
+    if (count >= PHASE_TIMELINE_ENTRIES) {
+        if (dropped < UINT16_MAX) dropped++;
+        return;
+    }
+
+    entries[count].machine = machine;
+    entries[count].state = state;
+    entries[count].offset_ms = now_ms - start_ms;
+    count++;
+}
+
+bool PhaseTimeline::Finish(uint32_t now_ms)
+{
+    if (!active) return false;
+
+    active = false;
+    elapsed_ms = now_ms - start_ms;
+    return true;
+}
+
+uint8_t PhaseTimeline::Format(uint8_t index, char * text, uint16_t size)
+{
+    uint16_t length = 0;
+    char entry[24];
+
+    if (0 == size) return index;
+    text[0] = '\0';
+
+    while (index < count) {
+        int written = snprintf(entry, sizeof(entry), "%s%s.%u@%lu", (length > 0) ? " " : "",
+                               MachineName(entries[index].machine), entries[index].state,
+                               (unsigned long) entries[index].offset_ms);
+        if (written < 0 || length + written >= size) break;
+
+        memcpy(text + length, entry, written + 1);
+        length += written;
+        index++;
+    }
+
+    return index;
+}
+
+const char * PhaseTimeline::MachineName(uint8_t machine)
+{
+    switch (machine) {
+    case TL_PROFILE:
+        return "PR";
+    case TL_REDOCK:
+        return "RD";
+    case TL_OFFLOAD:
+        return "OF";
+    case TL_CHECK_PU:
+        return "CK";
+    case TL_PU_BAUD:
+        return "BD";
+    default:
+        return "??";
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ *  PhaseTimeline.h
+ *  Created: October 2026
+ *
+ *  A timeline of the state-machine states visited during one profile, redock
+ *  or offload run, for measuring where a run spends its time on the bench.
+ *  Each flight state machine notes its current state every time it is called;
+ *  only changes are recorded, as (machine, state, ms since the run started),
+ *  so nested machines (CheckPU inside Profile, for example) interleave in the
+ *  order they ran. Resolution is one main loop.
+ *
+ *  Entries past PHASE_TIMELINE_ENTRIES are counted but not kept.
+ */
+
+#ifndef PHASETIMELINE_H
+#define PHASETIMELINE_H
+
+#include "Arduino.h"
+
+#define PHASE_TIMELINE_ENTRIES  64
+
+enum TimelineMachine_t : uint8_t {
+    TL_PROFILE,
+    TL_REDOCK,
+    TL_OFFLOAD,
+    TL_CHECK_PU,
+    TL_PU_BAUD,
+    TL_NUM_MACHINES
+};
+
+struct TimelineEntry_t {
+    uint8_t machine;
+    uint8_t state;
+    uint32_t offset_ms;
+};
+
+class PhaseTimeline {
+public:
+    PhaseTimeline() { };
+    ~PhaseTimeline() { };
+
+    // Begin a run of the top-level machine, dropping the previous timeline
+    void Start(TimelineMachine_t machine, uint32_t now_ms);
+
+    // Record the state a machine is in; ignored outside a run or if unchanged
+    void Note(TimelineMachine_t machine, uint8_t state, uint32_t now_ms);
+
+    // End the run; returns false if none was active
+    bool Finish(uint32_t now_ms);
+
+    bool Active() { return active; }
+    TimelineMachine_t Top() { return top; }
+    uint8_t Count() { return count; }
+    uint16_t Dropped() { return dropped; }
+    uint32_t ElapsedMs() { return elapsed_ms; }
+    const TimelineEntry_t & Entry(uint8_t index) { return entries[index]; }
+
+    // Write entries from index onward into text as "machine.state@ms"
+    // separated by spaces, as many as fit; returns the index to continue from
+    uint8_t Format(uint8_t index, char * text, uint16_t size);
+
+    static const char * MachineName(uint8_t machine);
+
+private:
+    TimelineEntry_t entries[PHASE_TIMELINE_ENTRIES];
+    uint8_t last_state[TL_NUM_MACHINES];
+    bool seen[TL_NUM_MACHINES];
+
+    TimelineMachine_t top = TL_PROFILE;
+    bool active = false;
+    uint8_t count = 0;
+    uint16_t dropped = 0;
+    uint32_t start_ms = 0;
+    uint32_t elapsed_ms = 0;
+};
+
+#endif /* PHASETIMELINE_H */
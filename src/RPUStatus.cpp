@@ -0,0 +1,316 @@
+/*
+ *  RPUStatus.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the typed RPU status snapshot: a small parser for
+ *  the flat status object and the renderer for the "rpu" report block.
+ */
+
+#include "RPUStatus.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdlib.h>
+
+#define RPU_STATUS_VALUE_KEY(value, key) key,
+
+static const char * const value_keys[RPU_NUM_VALUES] = {
+    RPU_STATUS_VALUES(RPU_STATUS_VALUE_KEY)
+};
+
+static const char * SkipSpace(const char * json)
+{
+    while (' ' == *json || '\t' == *json || '\r' == *json || '\n' == *json) json++;
+    return json;
+}
+
+bool RPUStatus::Capture(RPUStatusSource_t new_source, const char * json, uint32_t new_rx_ms, uint32_t new_rx_epoch)
+{
+    // validate the whole object before touching the snapshot
+    if (RPU_SRC_NONE == new_source || NULL == json || !Parse(json, false)) return false;
+
+    Parse(json, true);
+
+    for (uint8_t value = 0; value < RPU_NUM_VALUES; value++) {
+        value_index[value] = -1;
+        for (uint8_t i = 0; i < num_fields; i++) {
+            if (0 == strcmp(fields[i].key, value_keys[value])) {
+                value_index[value] = (int8_t) i;
+                break;
+            }
+        }
+    }
+
+    source = new_source;
+    rx_ms = new_rx_ms;
+    rx_epoch = new_rx_epoch;
+    pending = true;
+    return true;
+}
+
+const char * RPUStatus::SourceName()
+{
+    switch (source) {
+    case RPU_SRC_LORA:
+        return "LORA";
+    case RPU_SRC_DOCK:
+        return "DOCK";
+    default:
+        return "NONE";
+    }
+}
+
+int32_t RPUStatus::AgeSeconds(uint32_t now_ms)
+{
+    if (!Valid()) return -1;
+
+    return (int32_t) ((now_ms - rx_ms) / 1000UL);
+}
+
+bool RPUStatus::Value(RPUStatusValue_t value, float * result)
+{
+    if (!Valid() || value >= RPU_NUM_VALUES || value_index[value] < 0) return false;
+
+    const RPUStatusField_t & field = fields[value_index[value]];
+    if (RPU_FIELD_NUMBER != field.kind) return false;
+
+    *result = (float) field.number;
+    return true;
+}
+
+const char * RPUStatus::ValueKey(RPUStatusValue_t value)
+{
+    return (value < RPU_NUM_VALUES) ? value_keys[value] : "";
+}
+
+// A JSON string starting at its opening quote, unescaped into out (when
+// given). Returns the character after the closing quote, or NULL if the
+// string is malformed. *fits is cleared if out was too small.
+const char * RPUStatus::ParseString(const char * json, char * out, uint16_t size, bool * fits)
+{
+    uint16_t length = 0;
+    bool fit = true;
+
+    if ('"' != *json) return NULL;
+    json++;
+
+    while ('"' != *json) {
+        char c = *json++;
+        if ('\0' == c || (uint8_t) c < 0x20) return NULL;
+
+        if ('\\' == c) {
+            switch (*json++) {
+            case '"':  c = '"'; break;
+            case '\\': c = '\\'; break;
+            case '/':  c = '/'; break;
+            case 'b':  c = '\b'; break;
+            case 'f':  c = '\f'; break;
+            case 'n':  c = '\n'; break;
+            case 'r':  c = '\r'; break;
+            case 't':  c = '\t'; break;
+            case 'u': {
+                // no status field is expected outside ASCII; keep anything else as '?'
+                char hex[5] = {0};
+                for (uint8_t i = 0; i < 4; i++) {
+                    if (!isxdigit((unsigned char) json[i])) return NULL;
+                    hex[i] = json[i];
+                }
+                json += 4;
+                long code = strtol(hex, NULL, 16);
+                c = (code > 0 && code < 0x80) ? (char) code : '?';
+                break;
+            }
+            default:
+                return NULL;
+            }
+        }
+
+        if (NULL != out) {
+            if (length + 1 < size) {
+                out[length++] = c;
+            } else {
+                fit = false;
+            }
+        }
+    }
+
+    if (NULL != out && size > 0) out[length] = '\0';
+    if (NULL != fits && !fit) *fits = false;
+    return json + 1;
+}
+
+// A nested object or array starting at its opening bracket. Returns the
+// character after the matching close, or NULL if it never closes.
+const char * RPUStatus::SkipNested(const char * json)
+{
+    uint16_t depth = 0;
+
+    do {
+        switch (*json) {
+        case '\0':
+            return NULL;
+        case '"':
+            json = ParseString(json, NULL, 0, NULL);
+            if (NULL == json) return NULL;
+            continue;
+        case '{':
+        case '[':
+            depth++;
+            break;
+        case '}':
+        case ']':
+            depth--;
+            break;
+        default:
+            break;
+        }
+        json++;
+    } while (depth > 0);
+
+    return json;
+}
+
+// One flat JSON object. With store set the field table is rebuilt from it;
+// without, the text is only checked, so a malformed status never replaces a
+// good one.
+bool RPUStatus::Parse(const char * json, bool store)
+{
+    RPUStatusField_t field;
+    uint8_t kept = 0;
+    uint16_t dropped = 0;
+
+    json = SkipSpace(json);
+    if ('{' != *json) return false;
+    json = SkipSpace(json + 1);
+
+    bool first = true;
+    while ('}' != *json || !first) {
+        if (!first) {
+            if ('}' == *json) break;
+            if (',' != *json) return false;
+            json = SkipSpace(json + 1);
+        }
+        first = false;
+
+        bool fits = true;
+        json = ParseString(json, field.key, sizeof(field.key), &fits);
+        if (NULL == json) return false;
+        json = SkipSpace(json);
+        if (':' != *json) return false;
+        json = SkipSpace(json + 1);
+
+        if ('"' == *json) {
+            field.kind = RPU_FIELD_TEXT;
+            json = ParseString(json, field.text, sizeof(field.text), &fits);
+        } else if ('{' == *json || '[' == *json) {
+            fits = false;
+            json = SkipNested(json);
+        } else if (0 == strncmp(json, "true", 4) || 0 == strncmp(json, "null", 4)) {
+            field.kind = RPU_FIELD_LITERAL;
+            strncpy(field.text, json, 4);
+            field.text[4] = '\0';
+            json += 4;
+        } else if (0 == strncmp(json, "false", 5)) {
+            field.kind = RPU_FIELD_LITERAL;
+            strcpy(field.text, "false");
+            json += 5;
+        } else if ('-' == *json || isdigit((unsigned char) *json)) {
+            // strtod also takes nan and inf, which JSON has no way to render
+            char * end = NULL;
+            field.kind = RPU_FIELD_NUMBER;
+            field.number = strtod(json, &end);
+            json = (end == json || !isfinite(field.number)) ? NULL : end;
+        } else {
+            return false;
+        }
+        if (NULL == json) return false;
+        json = SkipSpace(json);
+
+        if (!fits || kept >= RPU_STATUS_MAX_FIELDS) {
+            dropped++;
+        } else {
+            if (store) fields[kept] = field;
+            kept++;
+        }
+    }
+
+    // nothing may follow the object
+    if ('\0' != *SkipSpace(json + 1)) return false;
+
+    if (store) {
+        num_fields = kept;
+        skipped = dropped;
+    }
+    return true;
+}
+
+// Appends printf-style text to a bounded buffer; false once it has run out
+static bool Append(char * json, uint16_t size, uint16_t * length, const char * format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static bool Append(char * json, uint16_t size, uint16_t * length, const char * format, ...)
+{
+    if (*length >= size) return false;
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(json + *length, size - *length, format, args);
+    va_end(args);
+
+    if (written < 0 || written >= size - *length) {
+        *length = size;
+        return false;
+    }
+    *length += (uint16_t) written;
+    return true;
+}
+
+static bool AppendString(char * json, uint16_t size, uint16_t * length, const char * text)
+{
+    if (!Append(json, size, length, "\"")) return false;
+
+    for (; '\0' != *text; text++) {
+        bool fits;
+        if ('"' == *text || '\\' == *text) {
+            fits = Append(json, size, length, "\\%c", *text);
+        } else if ((uint8_t) *text < 0x20) {
+            fits = Append(json, size, length, "\\u%04x", (unsigned) *text);
+        } else {
+            fits = Append(json, size, length, "%c", *text);
+        }
+        if (!fits) return false;
+    }
+
+    return Append(json, size, length, "\"");
+}
+
+bool RPUStatus::Render(char * json, uint16_t size)
+{
+    uint16_t length = 0;
+
+    if (!Valid() || 0 == size) return false;
+
+    bool fits = Append(json, size, &length, "{\"ver\":%u", (unsigned) RPU_STATUS_VERSION);
+    for (uint8_t i = 0; fits && i < num_fields; i++) {
+        fits = Append(json, size, &length, ",") && AppendString(json, size, &length, fields[i].key)
+               && Append(json, size, &length, ":");
+        if (!fits) break;
+
+        switch (fields[i].kind) {
+        case RPU_FIELD_NUMBER:
+            fits = Append(json, size, &length, "%.10g", fields[i].number);
+            break;
+        case RPU_FIELD_TEXT:
+            fits = AppendString(json, size, &length, fields[i].text);
+            break;
+        default:
+            fits = Append(json, size, &length, "%s", fields[i].text);
+            break;
+        }
+    }
+    if (fits && skipped > 0) fits = Append(json, size, &length, ",\"skipped\":%u", (unsigned) skipped);
+    if (fits) fits = Append(json, size, &length, "}");
+
+    if (!fits) json[0] = '\0';
+    return fits;
+}
@@ -0,0 +1,118 @@
+/*
+ *  RPUStatus.h
+ *  Created: October 2026
+ *
+ *  The most recent RPU status, whichever link it arrived on, as a typed and
+ *  versioned snapshot. Both sources arrive as a JSON object: a LoRa status
+ *  is decoded by RPUPacket and rendered once by its toJSON(), and a dock
+ *  status is the RX_Status() text. Capture() parses that object once into a
+ *  table of named fields (numbers, strings, and true/false/null), and looks
+ *  up the values on-board logic reads (RPU_STATUS_VALUES) so that reading
+ *  one is an array index rather than a string search.
+ *
+ *  The snapshot carries its source, the millis() and epoch it was received
+ *  at, and a pending flag. The "rpu" JSON block is rendered from the field
+ *  table only when a RACHUTSREPORT is built, led by RPU_STATUS_VERSION,
+ *  which changes whenever the rendered layout does. Nested objects and
+ *  arrays, and fields past RPU_STATUS_MAX_FIELDS, are counted but not kept.
+ */
+
+#ifndef RPUSTATUS_H
+#define RPUSTATUS_H
+
+#include "Arduino.h"
+
+#define RPU_STATUS_VERSION      2
+#define RPU_STATUS_MAX_FIELDS   32
+#define RPU_STATUS_KEY_SIZE     16      // longest key kept, with its terminator
+#define RPU_STATUS_TEXT_SIZE    24      // longest string value kept, with its terminator
+#define RPU_STATUS_TEXT_IN      512     // dock status text buffer (RX_Status)
+#define RPU_STATUS_JSON_SIZE    1024    // rendered "rpu" block
+
+//  X(value, key): the fields on-board logic reads, by their key in the RPU's
+//  status JSON. A key the RPU didn't send reads as absent.
+#define RPU_STATUS_VALUES(X) \
+    X(RPU_BATTERY_TEMP,     "TBat")     \
+    X(RPU_BATTERY_VOLTS,    "VBat")     \
+    X(RPU_RECORDS,          "Records")  \
+    X(RPU_STATE,            "State")
+
+#define RPU_STATUS_VALUE_ENUM(value, key) value,
+
+enum RPUStatusValue_t : uint8_t {
+    RPU_STATUS_VALUES(RPU_STATUS_VALUE_ENUM)
+    RPU_NUM_VALUES
+};
+
+enum RPUStatusSource_t : uint8_t {
+    RPU_SRC_NONE,
+    RPU_SRC_LORA,       // RPUPacket, through toJSON()
+    RPU_SRC_DOCK,       // RX_Status() JSON text
+};
+
+enum RPUFieldKind_t : uint8_t {
+    RPU_FIELD_NUMBER,
+    RPU_FIELD_TEXT,     // a JSON string, rendered quoted
+    RPU_FIELD_LITERAL,  // true, false or null, rendered as is
+};
+
+struct RPUStatusField_t {
+    char key[RPU_STATUS_KEY_SIZE];
+    uint8_t kind;       // RPUFieldKind_t
+    double number;
+    char text[RPU_STATUS_TEXT_SIZE];
+};
+
+class RPUStatus {
+public:
+    RPUStatus() { };
+    ~RPUStatus() { };
+
+    // Replace the snapshot with a parsed status object; false (and unchanged)
+    // if the text isn't a JSON object
+    bool Capture(RPUStatusSource_t source, const char * json, uint32_t rx_ms, uint32_t rx_epoch);
+
+    bool Valid() { return RPU_SRC_NONE != source; }
+    RPUStatusSource_t Source() { return source; }
+    const char * SourceName();
+    uint32_t ReceivedMs() { return rx_ms; }
+    uint32_t ReceivedEpoch() { return rx_epoch; }
+
+    // Seconds since the snapshot was received, -1 if there is none
+    int32_t AgeSeconds(uint32_t now_ms);
+
+    // A snapshot that hasn't been included in a report yet
+    bool Pending() { return pending; }
+    void MarkReported() { pending = false; }
+
+    // A numeric value of the snapshot; false if the RPU didn't send it as a number
+    bool Value(RPUStatusValue_t value, float * result);
+
+    // The snapshot's fields, in the order received
+    uint8_t Fields() { return num_fields; }
+    const RPUStatusField_t & Field(uint8_t index) { return fields[index]; }
+    uint16_t Skipped() { return skipped; }
+
+    // Render the snapshot's JSON object; false if there is none or it doesn't fit
+    bool Render(char * json, uint16_t size);
+
+    static const char * ValueKey(RPUStatusValue_t value);
+
+private:
+    // Parse one JSON object into the field table; false if malformed
+    bool Parse(const char * json, bool store);
+    const char * ParseString(const char * json, char * out, uint16_t size, bool * fits);
+    const char * SkipNested(const char * json);
+
+    RPUStatusSource_t source = RPU_SRC_NONE;
+    uint32_t rx_ms = 0;
+    uint32_t rx_epoch = 0;
+    bool pending = false;
+
+    RPUStatusField_t fields[RPU_STATUS_MAX_FIELDS];
+    uint8_t num_fields = 0;
+    uint16_t skipped = 0;
+    int8_t value_index[RPU_NUM_VALUES];     // into fields, -1 if absent
+};
+
+#endif /* RPUSTATUS_H */
@@ -0,0 +1,182 @@
+/*
+ *  ReedSolomon.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the GF(2^8) Reed-Solomon codec used for dock-link FEC.
+ */
+
+#include "ReedSolomon.h"
+
+#define RS_PRIMITIVE_POLY 0x11D
+
+ReedSolomon::ReedSolomon()
+{
+    uint16_t x = 1;
+
+    for (uint16_t i = 0; i < RS_BLOCK_SIZE; i++) {
+        gf_exp[i] = (uint8_t) x;
+        gf_log[x] = (uint8_t) i;
+        x <<= 1;
+        if (x & 0x100) x ^= RS_PRIMITIVE_POLY;
+    }
+
+    for (uint16_t i = RS_BLOCK_SIZE; i < sizeof(gf_exp); i++) {
+        gf_exp[i] = gf_exp[i - RS_BLOCK_SIZE];
+    }
+
+    gf_log[0] = 0; // undefined, never used
+}
+
+void ReedSolomon::Encode(const uint8_t * data, uint16_t data_length, uint8_t nsym, uint8_t * parity)
+{
+    uint8_t generator[RS_MAX_PARITY + 1] = {0};
+
+    if (nsym > RS_MAX_PARITY) return;
+
+    // generator polynomial (x - a^0)(x - a^1)...(x - a^(nsym-1)), lowest degree first
+    generator[0] = 1;
+    for (uint8_t j = 0; j < nsym; j++) {
+        for (uint8_t i = j + 1; i > 0; i--) {
+            generator[i] = generator[i - 1] ^ Multiply(generator[i], gf_exp[j]);
+        }
+        generator[0] = Multiply(generator[0], gf_exp[j]);
+    }
+
+    // systematic encoding: parity is the remainder of data(x) * x^nsym / g(x),
+    // computed with a shift register holding the highest-degree term first
+    memset(parity, 0, nsym);
+    for (uint16_t i = 0; i < data_length; i++) {
+        uint8_t feedback = data[i] ^ parity[0];
+        memmove(parity, parity + 1, nsym - 1);
+        parity[nsym - 1] = 0;
+        if (0 == feedback) continue;
+        for (uint8_t j = 0; j < nsym; j++) {
+            parity[j] ^= Multiply(feedback, generator[nsym - 1 - j]);
+        }
+    }
+}
+
+int ReedSolomon::Decode(uint8_t * codeword, uint16_t length, uint8_t nsym)
+{
+    uint8_t syndromes[RS_MAX_PARITY];
+    uint8_t locator[RS_MAX_PARITY + 1] = {0};
+    uint8_t previous[RS_MAX_PARITY + 1] = {0};
+    uint8_t scratch[RS_MAX_PARITY + 1];
+    uint8_t evaluator[RS_MAX_PARITY] = {0};
+    uint8_t derivative[RS_MAX_PARITY] = {0};
+    uint8_t errors = 0;
+    uint8_t shift = 1;
+    uint8_t last_discrepancy = 1;
+    int corrected = 0;
+
+    if (nsym > RS_MAX_PARITY || 0 == nsym || length > RS_BLOCK_SIZE || length <= nsym) return -1;
+
+    if (Syndromes(codeword, length, nsym, syndromes)) return 0;
+
+    // Berlekamp-Massey: find the error locator polynomial, lowest degree first
+    locator[0] = 1;
+    previous[0] = 1;
+    for (uint8_t r = 0; r < nsym; r++) {
+        uint8_t discrepancy = syndromes[r];
+        for (uint8_t i = 1; i <= errors; i++) {
+            discrepancy ^= Multiply(locator[i], syndromes[r - i]);
+        }
+
+        if (0 == discrepancy) {
+            shift++;
+            continue;
+        }
+
+        uint8_t scale = Divide(discrepancy, last_discrepancy);
+        memcpy(scratch, locator, sizeof(scratch));
+        for (uint8_t i = 0; i + shift <= RS_MAX_PARITY; i++) {
+            locator[i + shift] ^= Multiply(scale, previous[i]);
+        }
+
+        if (2 * errors <= r) {
+            errors = r + 1 - errors;
+            memcpy(previous, scratch, sizeof(previous));
+            last_discrepancy = discrepancy;
+            shift = 1;
+        } else {
+            shift++;
+        }
+    }
+
+    if (2 * errors > nsym) return -1;
+
+    // error evaluator: S(x) * locator(x) mod x^nsym
+    for (uint8_t i = 0; i < nsym; i++) {
+        for (uint8_t j = 0; j <= i && j <= errors; j++) {
+            evaluator[i] ^= Multiply(locator[j], syndromes[i - j]);
+        }
+    }
+
+    // formal derivative of the locator: only odd powers survive in GF(2^m)
+    for (uint8_t i = 1; i <= errors; i += 2) {
+        derivative[i - 1] = locator[i];
+    }
+
+    // Chien search over the codeword positions, Forney for each error value.
+    // Symbol i is the coefficient of x^(length - 1 - i).
+    for (uint16_t i = 0; i < length; i++) {
+        uint8_t power = (uint8_t) (length - 1 - i);
+        uint8_t x_inverse = gf_exp[(RS_BLOCK_SIZE - power) % RS_BLOCK_SIZE];
+
+        if (0 != Evaluate(locator, errors, x_inverse)) continue;
+
+        uint8_t denominator = Evaluate(derivative, (errors > 0) ? errors - 1 : 0, x_inverse);
+        if (0 == denominator) return -1;
+
+        uint8_t magnitude = Divide(Evaluate(evaluator, nsym - 1, x_inverse), denominator);
+        codeword[i] ^= Multiply(gf_exp[power], magnitude);
+        corrected++;
+    }
+
+    if (corrected != errors) return -1;
+
+    // guard against miscorrection beyond the code's capability
+    if (!Syndromes(codeword, length, nsym, syndromes)) return -1;
+
+    return corrected;
+}
+
+uint8_t ReedSolomon::Multiply(uint8_t a, uint8_t b)
+{
+    if (0 == a || 0 == b) return 0;
+    return gf_exp[gf_log[a] + gf_log[b]];
+}
+
+uint8_t ReedSolomon::Divide(uint8_t a, uint8_t b)
+{
+    if (0 == a || 0 == b) return 0;
+    return gf_exp[gf_log[a] + RS_BLOCK_SIZE - gf_log[b]];
+}
+
+uint8_t ReedSolomon::Evaluate(const uint8_t * poly, uint8_t degree, uint8_t x)
+{
+    uint8_t result = poly[degree];
+
+    for (int i = degree - 1; i >= 0; i--) {
+        result = Multiply(result, x) ^ poly[i];
+    }
+
+    return result;
+}
+
+bool ReedSolomon::Syndromes(const uint8_t * codeword, uint16_t length, uint8_t nsym, uint8_t * syndromes)
+{
+    bool clean = true;
+
+    // Horner's rule at a^j, highest-degree symbol first
+    for (uint8_t j = 0; j < nsym; j++) {
+        uint8_t result = 0;
+        for (uint16_t i = 0; i < length; i++) {
+            result = Multiply(result, gf_exp[j]) ^ codeword[i];
+        }
+        syndromes[j] = result;
+        if (0 != result) clean = false;
+    }
+
+    return clean;
+}
@@ -0,0 +1,54 @@
+/*
+ *  ReedSolomon.h
+ *  Created: October 2026
+ *
+ *  A small Reed-Solomon codec over GF(2^8) (primitive polynomial 0x11D,
+ *  generator roots alpha^0 .. alpha^(nsym-1)) used to protect dock-link
+ *  profile records. Codewords are at most 255 symbols; shorter (shortened)
+ *  codewords are supported, and the number of parity symbols is chosen per
+ *  call so the RPU can trade overhead for correction strength.
+ *
+ *  A codeword is stored data first, parity last. Decoding corrects up to
+ *  nsym/2 symbol errors in place (Berlekamp-Massey, Chien search, Forney) and
+ *  re-checks the syndromes afterwards. That catches most codewords with more
+ *  errors than that, but not all: beyond nsym/2 errors the received word can
+ *  lie within nsym/2 of a different codeword, which decodes "successfully" to
+ *  the wrong data. Records rely on their CRC-32 (LinkProtocol.h) for those.
+ */
+
+#ifndef REEDSOLOMON_H
+#define REEDSOLOMON_H
+
+#include "Arduino.h"
+
+#define RS_BLOCK_SIZE   255 // maximum codeword length in symbols
+#define RS_MAX_PARITY   32  // maximum parity symbols per codeword
+
+class ReedSolomon {
+public:
+    ReedSolomon();
+    ~ReedSolomon() { };
+
+    // Compute the nsym parity symbols for data_length data symbols, writing
+    // them to parity. data_length + nsym must not exceed RS_BLOCK_SIZE.
+    void Encode(const uint8_t * data, uint16_t data_length, uint8_t nsym, uint8_t * parity);
+
+    // Correct a codeword of length symbols (data followed by nsym parity) in
+    // place. Returns the number of symbols corrected, or -1 if uncorrectable.
+    int Decode(uint8_t * codeword, uint16_t length, uint8_t nsym);
+
+private:
+    uint8_t Multiply(uint8_t a, uint8_t b);
+    uint8_t Divide(uint8_t a, uint8_t b);
+
+    // Evaluate a polynomial (coefficients lowest degree first) at x
+    uint8_t Evaluate(const uint8_t * poly, uint8_t degree, uint8_t x);
+
+    // Syndromes of a codeword, returns true if all are zero
+    bool Syndromes(const uint8_t * codeword, uint16_t length, uint8_t nsym, uint8_t * syndromes);
+
+    uint8_t gf_exp[2 * RS_BLOCK_SIZE + 2]; // doubled so products need no modulo
+    uint8_t gf_log[RS_BLOCK_SIZE + 1];
+};
+
+#endif /* REEDSOLOMON_H */
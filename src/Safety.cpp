@@ -33,6 +33,7 @@ void StratoRachuts::SafetyMode()
 {
     mode_code = "SA";
     SendPeriodicRACHUTSREPORT();
+    SendLoRaRecordTM(false);
     switch (inst_substate) {
     case SA_ENTRY:
         // perform setup
@@ -75,7 +76,7 @@ void StratoRachuts::SafetyMode()
             inst_substate = SA_VERIFY_DOCK;
             scheduler.AddAction(RESEND_MOTION_COMMAND, MCB_RESEND_TIMEOUT);
         } else {
-            SendTextTM("Motion start error", WARN);
+            SendTextTM(TXT_MOTION_START_ERROR, WARN);
             inst_substate = MODE_ERROR;
         }
         break;
@@ -126,7 +127,7 @@ void StratoRachuts::SafetyMode()
         break;
 
     case SA_ACK_WAIT:
-        log_debug("Waiting on safety ack");
+        LOG_DEBUG("Waiting on safety ack");
         // check if the ack has been received
         if (S_ack_flag == ACK) {
             // clear the ack flag and go to the loop
@@ -146,12 +147,12 @@ void StratoRachuts::SafetyMode()
 
     case SA_LOOP:
         // nominal ops
-        log_debug("SA loop");
+        LOG_DEBUG("SA loop");
         digitalWrite(SAFE_PIN, HIGH);
         break;
 
     case SA_ERROR_LANDING:
-        log_debug("SA error");
+        LOG_DEBUG("SA error");
         break;
 
     case SA_SHUTDOWN:
@@ -0,0 +1,257 @@
+/*
+ *  SerialDMA.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the eDMA receive path for Serial2 (LPUART4), and the
+ *  host model that stands in for the channel off the Teensy.
+ */
+
+#include "SerialDMA.h"
+
+SerialDMA * SerialDMA::active = NULL;
+
+SerialDMA::SerialDMA(uint8_t * ring_buffer, uint16_t ring_length)
+    : ring(ring_buffer)
+    , ring_size(ring_length)
+{
+}
+
+uint32_t SerialDMA::Received()
+{
+    uint32_t lap;
+    uint32_t head;
+
+    // re-read if a lap completed between the two reads
+    do {
+        lap = wraps;
+        head = Head();
+    } while (lap != wraps);
+
+    // the channel may have wrapped before its completion interrupt ran
+    uint32_t total = lap * ring_size + head;
+    if (total < last_total) total += ring_size;
+    last_total = total;
+
+    return total;
+}
+
+int SerialDMA::available()
+{
+    uint32_t total = Received();
+
+    // the reader fell a full ring behind and the oldest bytes were overwritten;
+    // drop everything held and let the framer resync on what follows
+    if (total - consumed > ring_size) {
+        overruns++;
+        consumed = total;
+    }
+
+    return (int) (total - consumed);
+}
+
+int SerialDMA::read()
+{
+    if (0 == available()) return -1;
+    return ring[consumed++ % ring_size];
+}
+
+int SerialDMA::peek()
+{
+    if (0 == available()) return -1;
+    return ring[consumed % ring_size];
+}
+
+size_t SerialDMA::readBytes(char * buffer, size_t length)
+{
+    uint32_t count = (uint32_t) available();
+    uint32_t start = consumed;
+    if (count > length) count = (uint32_t) length;
+
+    // the held bytes wrap past the end of the ring at most once
+    uint32_t offset = start % ring_size;
+    uint32_t first = ring_size - offset;
+    if (first > count) first = count;
+    memcpy(buffer, ring + offset, first);
+    memcpy(buffer + first, ring, count - first);
+
+    // the channel may have lapped the reader during the copy
+    uint32_t total = Received();
+    if (total - start > ring_size) {
+        overruns++;
+        consumed = total;
+        return 0;
+    }
+
+    consumed = start + count;
+    return count;
+}
+
+#if defined(__IMXRT1062__)
+
+// the port this class drives; retarget here and in begin()
+#define DMA_PORT            Serial2
+#define DMA_PORT_IRQ        IRQ_LPUART4
+#define DMA_PORT_DMAMUX     DMAMUX_SOURCE_LPUART4_RX
+#define DMA_PORT_STAT       LPUART4_STAT
+#define DMA_PORT_CTRL       LPUART4_CTRL
+#define DMA_PORT_BAUD       LPUART4_BAUD
+#define DMA_PORT_WATER      LPUART4_WATER
+#define DMA_PORT_DATA       LPUART4_DATA
+
+// the write-1-to-clear flags in STAT; its other writable bits are configuration
+#define DMA_STAT_FLAGS      (LPUART_STAT_LBKDIF | LPUART_STAT_RXEDGIF | LPUART_STAT_IDLE | LPUART_STAT_OR \
+                             | LPUART_STAT_NF | LPUART_STAT_FE | LPUART_STAT_PF | LPUART_STAT_MA1F | LPUART_STAT_MA2F)
+#define DMA_STAT_ERRORS     (LPUART_STAT_OR | LPUART_STAT_FE | LPUART_STAT_NF | LPUART_STAT_PF)
+
+void SerialDMA::begin(uint32_t baud)
+{
+    active = this;
+
+    dma.disable();
+
+    // the core driver sets up pins, clocks, baud rate, and the FIFOs
+    DMA_PORT.begin(baud);
+
+    // take the vector from the core driver and stop its RX and TX interrupts
+    NVIC_DISABLE_IRQ(DMA_PORT_IRQ);
+    DMA_PORT_CTRL &= ~(LPUART_CTRL_RIE | LPUART_CTRL_TIE | LPUART_CTRL_TCIE);
+    attachInterruptVector(DMA_PORT_IRQ, IdleISR);
+
+    // request a transfer for every byte, so none wait below the watermark
+    DMA_PORT_WATER &= ~LPUART_WATER_RXWATER(3);
+
+    if (!dma_allocated) {
+        dma.begin(true);
+        dma.attachInterrupt(WrapISR);
+        dma_allocated = true;
+    }
+
+    dma.source((volatile uint8_t &) DMA_PORT_DATA);
+    dma.destinationCircular(ring, ring_size);
+    dma.triggerAtHardwareEvent(DMA_PORT_DMAMUX);
+    dma.interruptAtCompletion();
+
+    wraps = 0;
+    consumed = 0;
+    last_total = 0;
+    idle_lines = 0;
+    line_errors = 0;
+    overruns = 0;
+
+    dma.enable();
+    DMA_PORT_BAUD |= LPUART_BAUD_RDMAE;
+    DMA_PORT_CTRL |= LPUART_CTRL_ILIE | LPUART_CTRL_ORIE;
+    NVIC_ENABLE_IRQ(DMA_PORT_IRQ);
+}
+
+size_t SerialDMA::write(uint8_t b)
+{
+    while (!(DMA_PORT_STAT & LPUART_STAT_TDRE));
+    DMA_PORT_DATA = b;
+    return 1;
+}
+
+void SerialDMA::flush()
+{
+    while (!(DMA_PORT_STAT & LPUART_STAT_TC));
+}
+
+uint32_t SerialDMA::Head()
+{
+    return (uint32_t) ((uint8_t *) dma.destinationAddress() - ring);
+}
+
+void SerialDMA::WrapISR()
+{
+    active->dma.clearInterrupt();
+    active->wraps++;
+    asm("dsb");
+}
+
+void SerialDMA::IdleISR()
+{
+    uint32_t stat = DMA_PORT_STAT;
+    uint32_t clear = 0;
+
+    if (stat & LPUART_STAT_IDLE) {
+        clear |= LPUART_STAT_IDLE;
+        active->idle_lines++;
+    }
+
+    // the receiver stops storing data while an overrun is pending
+    if (stat & DMA_STAT_ERRORS) {
+        clear |= stat & DMA_STAT_ERRORS;
+        active->line_errors++;
+    }
+
+    // write the configuration bits back as read and a 1 to only the handled
+    // flags; OR-ing into STAT would also clear any other flag that was set
+    if (clear) DMA_PORT_STAT = (stat & ~DMA_STAT_FLAGS) | clear;
+
+    asm("dsb");
+}
+
+#else
+
+// Host model of the channel and its completion interrupt
+
+void SerialDMA::begin(uint32_t baud)
+{
+    (void) baud;
+
+    active = this;
+
+    host_head = 0;
+    host_pending_wraps = 0;
+    wraps = 0;
+    consumed = 0;
+    last_total = 0;
+    idle_lines = 0;
+    line_errors = 0;
+    overruns = 0;
+}
+
+void SerialDMA::HostDMA(const uint8_t * data, uint32_t length, bool defer_interrupt)
+{
+    while (length--) {
+        ring[host_head++] = *data++;
+        if (host_head == ring_size) {
+            host_head = 0;
+            if (defer_interrupt) {
+                host_pending_wraps++;
+            } else {
+                WrapISR();
+            }
+        }
+    }
+}
+
+void SerialDMA::HostInterrupt()
+{
+    while (host_pending_wraps > 0) {
+        host_pending_wraps--;
+        WrapISR();
+    }
+}
+
+uint32_t SerialDMA::Head()
+{
+    return host_head;
+}
+
+void SerialDMA::WrapISR()
+{
+    active->wraps++;
+}
+
+size_t SerialDMA::write(uint8_t b)
+{
+    (void) b;
+    return 1;
+}
+
+void SerialDMA::flush()
+{
+}
+
+#endif /* __IMXRT1062__ */
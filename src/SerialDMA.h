@@ -0,0 +1,108 @@
+/*
+ *  SerialDMA.h
+ *  Created: October 2026
+ *
+ *  eDMA-driven receive for the PU dock link (Serial2 / LPUART4 on the
+ *  Teensy 4.1), enabled with PU_SERIAL_DMA in PIBHardware.h.
+ *
+ *  The core HardwareSerial takes an interrupt per RX FIFO watermark and
+ *  copies each byte into its ring in software. Here the LPUART raises a DMA
+ *  request for every received byte and an eDMA channel stores it straight
+ *  into a circular ring; the CPU does no per-byte work on receive. The ring
+ *  position is read back from the channel's destination address, and a
+ *  completion interrupt once per lap keeps a running byte count so that a
+ *  reader that falls a full ring behind is detected (and resynchronised)
+ *  rather than handed overwritten data.
+ *
+ *  The LPUART idle-line interrupt marks the gaps between bursts (frames) and
+ *  clears receive errors. Since that interrupt shares the LPUART vector with
+ *  the core driver, this class owns the vector outright; transmit is
+ *  therefore polled through the 4-byte TX FIFO, which suits the short
+ *  PIB-to-RPU commands.
+ *
+ *  Only one instance is supported. The channel wraps the ring with modulo
+ *  addressing, so the ring must be a power of two no larger than 32 KB and
+ *  aligned to its own size; it should also live in DTCM (a normal global) so
+ *  no cache maintenance is needed.
+ *
+ *  Stream::readBytes() isn't virtual, so a reader that wants the bulk copy
+ *  out of the ring must call it through a SerialDMA (as SerialFramer does).
+ *
+ *  Off the Teensy the channel is replaced by a host model (HostDMA()) that
+ *  stores bytes into the ring the way the eDMA does, so the ring bookkeeping
+ *  can be tested on a workstation (test/test_serial_dma.cpp).
+ */
+
+#ifndef SERIALDMA_H
+#define SERIALDMA_H
+
+#include "Arduino.h"
+#if defined(__IMXRT1062__)
+#include <DMAChannel.h>
+#endif
+
+class SerialDMA : public Stream {
+public:
+    SerialDMA(uint8_t * ring_buffer, uint16_t ring_length);
+    ~SerialDMA() { };
+
+    // (Re)start the port at the given baud rate and take over its receive path.
+    // Any bytes buffered before the call are dropped.
+    void begin(uint32_t baud);
+
+    // Statistics since the last begin()
+    uint32_t Overruns() { return overruns; }
+    uint32_t IdleLines() { return idle_lines; }
+    uint32_t LineErrors() { return line_errors; }
+
+    // Stream interface
+    int available();
+    int read();
+    int peek();
+    size_t write(uint8_t b);
+    void flush();
+    using Print::write;
+
+    // Copy up to length held bytes out of the ring, without waiting for more
+    size_t readBytes(char * buffer, size_t length);
+
+#if !defined(__IMXRT1062__)
+    // Host model: store bytes into the ring as the channel would. A lap's
+    // completion interrupt runs at once, or with defer_interrupt only at the
+    // next HostInterrupt(), as when the channel wraps before its ISR runs.
+    void HostDMA(const uint8_t * data, uint32_t length, bool defer_interrupt = false);
+    void HostInterrupt();
+#endif
+
+private:
+    // Total bytes the DMA has written since begin()
+    uint32_t Received();
+
+    // Offset in the ring of the next byte the DMA will write
+    uint32_t Head();
+
+    static void WrapISR();
+    static SerialDMA * active;
+
+#if defined(__IMXRT1062__)
+    static void IdleISR();
+
+    DMAChannel dma;
+    bool dma_allocated = false;
+#else
+    uint32_t host_head = 0;
+    uint32_t host_pending_wraps = 0;
+#endif
+
+    uint8_t * ring;
+    uint16_t ring_size;
+    uint32_t consumed = 0;
+    uint32_t last_total = 0;
+
+    volatile uint32_t wraps = 0;
+    volatile uint32_t idle_lines = 0;
+    volatile uint32_t line_errors = 0;
+    uint32_t overruns = 0;
+};
+
+#endif /* SERIALDMA_H */
@@ -0,0 +1,393 @@
+/*
+ *  SerialFramer.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the resumable, non-blocking SerialComm frame parser.
+ */
+
+#include "SerialFramer.h"
+#include "SerialDMA.h"
+
+SerialFramer::SerialFramer(Stream * link_stream)
+    : link(link_stream)
+{
+}
+
+SerialFramer::SerialFramer(SerialDMA * dma_stream)
+    : link(dma_stream)
+    , dma_link(dma_stream)
+{
+}
+
+void SerialFramer::AssignFrameBuffer(uint8_t * buffer, uint16_t size)
+{
+    this->buffer = buffer;
+    buffer_size = size;
+    held = 0;
+    release_held = false;
+    frame = buffer;
+    frame_size = size;
+    fill = 0;
+    Restart();
+}
+
+bool SerialFramer::Poll()
+{
+    if (NULL == frame) return false;
+
+    // the previous frame has been handed off, release it
+    if (FR_READY == state) Release();
+
+    // nothing refers to the held frames any more; their space is reclaimed
+    // with the next compaction
+    if (release_held) {
+        held = 0;
+        release_held = false;
+    }
+
+    while (true) {
+        // parse everything already held before pulling more from the link
+        while (parse_index < fill) {
+            if (FR_HUNT == state) {
+                Hunt();
+            } else if (FR_BIN_DATA == state) {
+                // skip over as much of the payload as is already held in one go
+                uint16_t count = fill - parse_index;
+                if (count > bin_remaining) count = bin_remaining;
+                for (uint16_t i = 0; i < count; i++) {
+                    check_a += frame[parse_index + i];
+                    check_b += check_a;
+                }
+                parse_index += count;
+                bin_remaining -= count;
+                if (0 == bin_remaining) state = FR_BIN_END;
+            } else if (ParseByte(frame[parse_index++])) {
+                // a tag applies to the frame that follows it, keep parsing
+                if (ParseTag(&pending_tag)) {
+                    pending_tag_valid = true;
+                    Release();
+                    continue;
+                }
+
+                frame_tag_valid = pending_tag_valid;
+                frame_tag = pending_tag;
+                pending_tag_valid = false;
+
+                // once per frame, before any pointer into it is handed out,
+                // so a Hold() never pins the space in front of it
+                Compact();
+                return true;
+            }
+        }
+
+        int count = link->available();
+        if (count <= 0) return false;
+
+        // out of room: reclaim the space in front of the frame, and failing
+        // that the partial frame can never complete; with no partial frame
+        // the held frames take the whole buffer until they are released
+        if (fill >= frame_size) {
+            if (Compact()) continue;
+            if (0 == fill) return false;
+            Resync();
+            continue;
+        }
+
+        if (count > frame_size - fill) count = frame_size - fill;
+        uint16_t got = (NULL != dma_link) ? (uint16_t) dma_link->readBytes((char *) (frame + fill), count)
+                                          : (uint16_t) link->readBytes((char *) (frame + fill), count);
+        if (NULL != capture) capture->Add(capture_link, frame + fill, got, micros());
+        fill += got;
+    }
+}
+
+bool SerialFramer::FrameTag(uint8_t * seq)
+{
+    if (FR_READY != state || !frame_tag_valid) return false;
+    *seq = frame_tag;
+    return true;
+}
+
+void SerialFramer::SetCapture(LinkCapture * link_capture, CaptureLink_t link_id)
+{
+    capture = link_capture;
+    capture_link = link_id;
+}
+
+void SerialFramer::TX_Tag(uint8_t seq)
+{
+    TX_Command(LINK_SEQ_TAG, seq);
+}
+
+void SerialFramer::TX_Command(uint8_t msg_id, uint32_t param)
+{
+    char command[32];
+    int length = snprintf(command, sizeof(command), "%c%u%c%lu%c", FRAME_ASCII_START, msg_id,
+                          FRAME_SEPARATOR, (unsigned long) param, FRAME_TERMINATOR);
+    length += snprintf(command + length, sizeof(command) - length, "%u%c",
+                       Checksum((const uint8_t *) command, length), FRAME_TERMINATOR);
+    link->write((const uint8_t *) command, length);
+}
+
+bool SerialFramer::BinaryFrame(uint8_t * bin_id, uint8_t ** payload, uint16_t * length, bool * checksum_valid)
+{
+    if (FR_READY != state || FRAME_BIN_START != frame_type) return false;
+
+    *bin_id = (uint8_t) frame_id;
+    *payload = frame + payload_offset;
+    *length = payload_length;
+    *checksum_valid = (check_value == (uint32_t) (((uint16_t) check_a << 8) | check_b));
+    return true;
+}
+
+void SerialFramer::Hold()
+{
+    if (FR_READY != state) return;
+
+    // move the parse window past the frame; bytes received after it stay put,
+    // and any dropped bytes in front of the frame are held along with it
+    held = (uint16_t) (frame - buffer) + parse_index;
+    Advance(parse_index);
+    Restart();
+}
+
+bool SerialFramer::ParseTag(uint8_t * seq)
+{
+    uint16_t index = 1;
+    uint16_t value = 0;
+
+    if (FRAME_ASCII_START != frame[0]) return false;
+
+    while (index < parse_index && frame[index] >= '0' && frame[index] <= '9') {
+        value = value * 10 + (frame[index++] - '0');
+    }
+    if (LINK_SEQ_TAG != value || FRAME_SEPARATOR != frame[index++]) return false;
+
+    value = 0;
+    while (index < parse_index && frame[index] >= '0' && frame[index] <= '9') {
+        value = value * 10 + (frame[index++] - '0');
+    }
+    if (FRAME_TERMINATOR != frame[index] || value > 0xFF) return false;
+
+    *seq = (uint8_t) value;
+    return true;
+}
+
+uint16_t SerialFramer::Checksum(const uint8_t * data, uint16_t length)
+{
+    uint8_t check_a = 0;
+    uint8_t check_b = 0;
+
+    for (uint16_t i = 0; i < length; i++) {
+        check_a += data[i];
+        check_b += check_a;
+    }
+
+    return ((uint16_t) check_a << 8) | check_b;
+}
+
+void SerialFramer::Hunt()
+{
+    // Scan the held bytes once, up to the first start character; a scan that
+    // stops early costs only the bytes it skipped, so a run of false starts
+    // stays linear.
+    uint16_t start = 0;
+    while (start < fill) {
+        uint8_t rx = frame[start];
+        if (FRAME_ASCII_START == rx || FRAME_ACK_START == rx || FRAME_BIN_START == rx || FRAME_STRING_START == rx) break;
+        start++;
+    }
+
+    // everything before the start (or the whole buffer) is garbage, drop it in one step
+    Discard(start);
+    if (0 == fill) return;
+
+    frame_type = frame[0];
+    frame_id = 0;
+    payload_offset = 0;
+    payload_length = 0;
+    check_value = 0;
+    check_a = frame[0];
+    check_b = check_a;
+    field_digits = 0;
+    field_length = 0;
+    parse_index = 1;
+    state = FR_ID;
+}
+
+bool SerialFramer::ParseByte(uint8_t rx)
+{
+    bool is_digit = (rx >= '0' && rx <= '9');
+    bool malformed = false;
+
+    // the checksum covers everything from the start character through the
+    // terminator in front of the checksum digits
+    if (FR_CHECKSUM != state) {
+        check_a += rx;
+        check_b += check_a;
+    }
+
+    switch (state) {
+    case FR_ID:
+        if (is_digit) {
+            malformed = (++field_digits > FRAME_MAX_ID_DIGITS);
+            frame_id = frame_id * 10 + (rx - '0');
+        } else if (FRAME_SEPARATOR == rx && field_digits > 0) {
+            field_digits = 0;
+            field_length = 0;
+            state = (FRAME_BIN_START == frame_type) ? FR_BIN_LEN : FR_TEXT;
+        } else if (FRAME_TERMINATOR == rx && field_digits > 0 && FRAME_ASCII_START == frame_type) {
+            field_digits = 0;
+            state = FR_CHECKSUM;
+        } else {
+            malformed = true;
+        }
+        break;
+
+    case FR_TEXT:
+        if (FRAME_TERMINATOR == rx) {
+            field_digits = 0;
+            state = FR_CHECKSUM;
+        } else {
+            malformed = (++field_length > FRAME_MAX_TEXT);
+        }
+        break;
+
+    case FR_BIN_LEN:
+        if (is_digit && field_digits < FRAME_MAX_LEN_DIGITS) {
+            // five digits can exceed a uint16_t; don't let the length wrap
+            uint32_t length = (uint32_t) field_length * 10 + (rx - '0');
+            field_digits++;
+            field_length = (uint16_t) length;
+            malformed = (length > UINT16_MAX);
+        } else if (FRAME_TERMINATOR == rx && field_digits > 0) {
+            // the payload, its terminator, and the checksum must all fit once
+            // the space in front of the frame is reclaimed
+            if ((uint32_t) parse_index + field_length + 2 + FRAME_MAX_CSUM_DIGITS > (uint32_t) (buffer_size - held)) {
+                malformed = true;
+                break;
+            }
+            payload_offset = parse_index;
+            payload_length = field_length;
+            bin_remaining = field_length;
+            field_digits = 0;
+            state = (bin_remaining > 0) ? FR_BIN_DATA : FR_BIN_END;
+        } else {
+            malformed = true;
+        }
+        break;
+
+    case FR_BIN_END:
+        if (FRAME_TERMINATOR == rx) {
+            field_digits = 0;
+            state = FR_CHECKSUM;
+        } else {
+            malformed = true;
+        }
+        break;
+
+    case FR_CHECKSUM:
+        if (is_digit) {
+            malformed = (++field_digits > FRAME_MAX_CSUM_DIGITS);
+            check_value = check_value * 10 + (rx - '0');
+        } else if (FRAME_TERMINATOR == rx && field_digits > 0) {
+            read_index = 0;
+            state = FR_READY;
+            return true;
+        } else {
+            malformed = true;
+        }
+        break;
+
+    default:
+        malformed = true;
+        break;
+    }
+
+    if (malformed) Resync();
+
+    return false;
+}
+
+void SerialFramer::Resync()
+{
+    // Drop only the false start character; the next Hunt() rescans the rest of
+    // the failed frame, since a real frame may have begun inside it.
+    resync_count++;
+    Discard(1);
+    Restart();
+}
+
+void SerialFramer::Release()
+{
+    // keep any bytes that arrived after the consumed frame
+    Advance(parse_index);
+    Restart();
+}
+
+void SerialFramer::Discard(uint16_t count)
+{
+    if (0 == count) return;
+    discarded_bytes += count;
+    Advance(count);
+}
+
+void SerialFramer::Advance(uint16_t count)
+{
+    frame += count;
+    frame_size -= count;
+    fill -= count;
+}
+
+bool SerialFramer::Compact()
+{
+    uint8_t * base = buffer + held;
+    if (frame == base) return false;
+
+    // parse positions are relative to frame, so they survive the move
+    if (fill > 0) memmove(base, frame, fill);
+    frame_size += (uint16_t) (frame - base);
+    frame = base;
+    return true;
+}
+
+void SerialFramer::Restart()
+{
+    state = FR_HUNT;
+    parse_index = 0;
+    read_index = 0;
+    bin_remaining = 0;
+}
+
+int SerialFramer::available()
+{
+    if (FR_READY != state) return 0;
+    return parse_index - read_index;
+}
+
+int SerialFramer::read()
+{
+    if (FR_READY != state || read_index >= parse_index) return -1;
+    return frame[read_index++];
+}
+
+int SerialFramer::peek()
+{
+    if (FR_READY != state || read_index >= parse_index) return -1;
+    return frame[read_index];
+}
+
+size_t SerialFramer::write(uint8_t b)
+{
+    return link->write(b);
+}
+
+size_t SerialFramer::write(const uint8_t * buffer, size_t size)
+{
+    return link->write(buffer, size);
+}
+
+void SerialFramer::flush()
+{
+    link->flush();
+}
@@ -0,0 +1,214 @@
+/*
+ *  SerialFramer.h
+ *  Created: October 2026
+ *
+ *  A resumable, non-blocking frame parser that sits between a UART and a
+ *  SerialComm-derived interface (RPUComm/MCBComm). SerialComm's Read_* calls
+ *  busy-wait with per-field timeouts until a whole frame has arrived, which for
+ *  an RPU_PROFILE_RECORD (~7.7 KB, ~0.67 s at 115200) stalls the main loop.
+ *
+ *  The framer instead consumes only the bytes already in the UART ring each
+ *  call, keeping its parse state across loops. Once a complete frame has been
+ *  assembled it is exposed through the Stream interface, so the unchanged
+ *  SerialComm RX() parses it from memory without ever waiting. Writes pass
+ *  straight through to the underlying link.
+ *
+ *  Garbage on the link (line noise, unframed debug text from a peer) is
+ *  dropped in bulk: the held bytes are scanned once for the next start
+ *  character and everything before it is discarded in one step. A frame that
+ *  turns out to be malformed is rescanned from just past its start character,
+ *  so a real frame hidden inside it is still found in the same call.
+ *  Dropping and releasing bytes only moves the start of the parse window; the
+ *  buffer is compacted once per complete frame, or when it runs out of room,
+ *  so garbage full of start characters costs linear time rather than a move
+ *  of the buffer each.
+ *
+ *  Sequence tag frames (LINK_SEQ_TAG, see LinkProtocol.h) are consumed by the
+ *  framer itself and attached to the frame that follows them.
+ *
+ *  Every read from the link can also be copied to a LinkCapture ring.
+ *
+ *  The checksum is accumulated as bytes are parsed, so a BIN payload can also
+ *  be used in place through BinaryFrame() instead of being copied out by
+ *  SerialComm's Read_Bin(). A ready frame can be held in the buffer past the
+ *  next Poll(); later frames are then assembled behind it until the held
+ *  frames are released.
+ *
+ *  Frame formats (SerialComm):
+ *    ASCII:  #<id>[,<params>];<checksum>;
+ *    ACK:    ?<id>,<0|1>;<checksum>;
+ *    BIN:    !<id>,<length>;<length bytes>;<checksum>;
+ *    STRING: "<id>,<text>;<checksum>;
+ */
+
+#ifndef SERIALFRAMER_H
+#define SERIALFRAMER_H
+
+#include "Arduino.h"
+#include "LinkProtocol.h"
+#include "LinkCapture.h"
+
+// SerialComm frame delimiters
+#define FRAME_ASCII_START   '#'
+#define FRAME_ACK_START     '?'
+#define FRAME_BIN_START     '!'
+#define FRAME_STRING_START  '"'
+#define FRAME_SEPARATOR     ','
+#define FRAME_TERMINATOR    ';'
+
+// field limits used to reject garbage early
+#define FRAME_MAX_ID_DIGITS     3
+#define FRAME_MAX_LEN_DIGITS    5
+#define FRAME_MAX_CSUM_DIGITS   5
+#define FRAME_MAX_TEXT          512
+
+// worst-case bytes around a binary payload: start, id, separator, length,
+// terminators and checksum
+#define FRAME_OVERHEAD          32
+
+class SerialDMA;
+
+class SerialFramer : public Stream {
+public:
+    SerialFramer(Stream * link_stream);
+
+    // Read a DMA receive ring with its bulk copy rather than byte by byte
+    SerialFramer(SerialDMA * dma_stream);
+
+    ~SerialFramer() { };
+
+    // The buffer must hold the largest expected frame (payload + FRAME_OVERHEAD)
+    void AssignFrameBuffer(uint8_t * buffer, uint16_t size);
+
+    // Parse the bytes already buffered on the link without waiting for more.
+    // Returns true when a complete frame is ready to be read through the Stream
+    // interface. The frame stays valid until the next call to Poll().
+    bool Poll();
+
+    // If the ready frame was preceded by a sequence tag, return true and its value
+    bool FrameTag(uint8_t * seq);
+
+    // Copy every byte read from the link to the capture ring (NULL to stop)
+    void SetCapture(LinkCapture * link_capture, CaptureLink_t link_id);
+
+    // Send a sequence tag frame ahead of a request
+    void TX_Tag(uint8_t seq);
+
+    // Send a link extension command (LinkProtocol.h) with one numeric parameter
+    void TX_Command(uint8_t msg_id, uint32_t param);
+
+    // If the ready frame is a BIN frame, return true with its id, a pointer to
+    // its payload in the frame buffer, the payload length, and whether the
+    // checksum matched. The payload may be modified in place.
+    bool BinaryFrame(uint8_t * bin_id, uint8_t ** payload, uint16_t * length, bool * checksum_valid);
+
+    // Keep the ready frame (and any payload pointer into it) valid past the
+    // next Poll(), shrinking the space left for later frames accordingly
+    void Hold();
+
+    // Drop all held frames at the next Poll()
+    void ReleaseHeld() { release_held = (held > 0); }
+
+    // Bytes of the frame buffer currently taken by held frames
+    uint16_t HeldBytes() { return held; }
+
+    // Resync statistics since boot
+    uint32_t DiscardedBytes() { return discarded_bytes; }
+    uint32_t ResyncCount() { return resync_count; }
+
+    // Stream interface: reads serve the ready frame, writes go to the link
+    int available();
+    int read();
+    int peek();
+    size_t write(uint8_t b);
+    size_t write(const uint8_t * buffer, size_t size);
+    void flush();
+    using Print::write;
+
+private:
+    enum FramerState_t : uint8_t {
+        FR_HUNT,
+        FR_ID,
+        FR_TEXT,
+        FR_BIN_LEN,
+        FR_BIN_DATA,
+        FR_BIN_END,
+        FR_CHECKSUM,
+        FR_READY,
+    };
+
+    // Advance the state machine by one byte, returns true on a complete frame
+    bool ParseByte(uint8_t rx);
+
+    // Skip to the next start character in the held bytes
+    void Hunt();
+
+    // Abandon a malformed frame and rescan from just past its start
+    void Resync();
+
+    // Drop the consumed frame, keeping any bytes received after it
+    void Release();
+
+    // Remove bytes from the front of the buffer, counting them as discarded
+    void Discard(uint16_t count);
+
+    // Move the front of the parse window past bytes no longer needed
+    void Advance(uint16_t count);
+
+    // Move the parse window back against the held frames; false if it already is
+    bool Compact();
+
+    // Reset the parse state to hunt at the front of the buffer
+    void Restart();
+
+    // If the ready frame is a sequence tag, return true and its value
+    bool ParseTag(uint8_t * seq);
+
+    // SerialComm Fletcher-style checksum: (sum << 8) | sum-of-sums, mod 256 each
+    static uint16_t Checksum(const uint8_t * data, uint16_t length);
+
+    Stream * link;
+    SerialDMA * dma_link = NULL;
+
+    LinkCapture * capture = NULL;
+    CaptureLink_t capture_link = CAPTURE_MCB;
+
+    // held frames occupy [buffer, buffer + held), and [buffer + held, frame) is
+    // free until the next compaction; from frame, bytes [0, parse_index) belong
+    // to the current frame, [parse_index, fill) have been read from the link
+    // but not yet parsed
+    uint8_t * buffer = NULL;
+    uint16_t buffer_size = 0;
+    uint16_t held = 0;
+    bool release_held = false;
+    uint8_t * frame = NULL;
+    uint16_t frame_size = 0;
+    uint16_t fill = 0;
+    uint16_t parse_index = 0;
+    uint16_t read_index = 0;
+
+    FramerState_t state = FR_HUNT;
+    uint8_t frame_type = 0;
+    uint8_t field_digits = 0;
+    uint16_t field_length = 0;
+    uint16_t bin_remaining = 0;
+
+    // fields of the frame being parsed, and its running checksum
+    uint16_t frame_id = 0;
+    uint16_t payload_offset = 0;
+    uint16_t payload_length = 0;
+    uint32_t check_value = 0;
+    uint8_t check_a = 0;
+    uint8_t check_b = 0;
+
+    // tag received ahead of the next frame, and the tag of the ready frame
+    bool pending_tag_valid = false;
+    uint8_t pending_tag = 0;
+    bool frame_tag_valid = false;
+    uint8_t frame_tag = 0;
+
+    uint32_t discarded_bytes = 0;
+    uint32_t resync_count = 0;
+};
+
+#endif /* SERIALFRAMER_H */
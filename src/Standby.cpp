@@ -23,6 +23,7 @@ void StratoRachuts::StandbyMode()
 {
     mode_code = "SB";
     SendPeriodicRACHUTSREPORT();
+    SendLoRaRecordTM(false);
     switch (inst_substate) {
     case SB_ENTRY:
         log_nominal("Entering SB");
@@ -35,7 +36,7 @@ void StratoRachuts::StandbyMode()
         break;
     case SB_LOOP:
         // nominal ops
-        log_debug("SB loop");
+        LOG_DEBUG("SB loop");
 
         // send a mode request if time, and schedule the next
         if (CheckAction(SEND_IMR)) {
@@ -45,7 +46,7 @@ void StratoRachuts::StandbyMode()
         }
         break;
     case SB_ERROR_LANDING:
-        log_debug("SB error");
+        LOG_DEBUG("SB error");
         break;
     case SB_SHUTDOWN:
         // prep for shutdown
@@ -10,21 +10,73 @@
  *  for the RACHuTS Profiler Interface Board, or PIB.
  */
 
-int PacketSize = 0;
+#include "StratoRachuts.h"
+
+// set in InstrumentSetup(), before the callback is registered
+static LoRaQueue * lora_rx_queue = NULL;
 
 //ISR for LoRa reception, needs to be outside the class for some reason
+// The packet is copied out of the radio FIFO here, since the next packet
+// overwrites it; LoRaRX() handles it from the queue on the next loop.
 void onReceive(int Size)
 {
-    PacketSize = Size;
+    LoRaPacket_t * packet = lora_rx_queue->Reserve(Size);
+    if (NULL == packet) return;
+
+    for (int i = 0; i < Size; i++) {
+        packet->data[i] = (uint8_t) LoRa.read();
+    }
+    packet->rssi = (int16_t) LoRa.packetRssi();
+    packet->snr = LoRa.packetSnr();
+    packet->freq_error = (int32_t) LoRa.packetFrequencyError();
+    packet->rx_ms = millis();
+
+    lora_rx_queue->Commit();
 }
 
-#include "StratoRachuts.h"
+// ISR at the end of a LoRa transmission (see LoRaCommandTX()): back to listening
+void onTxDone()
+{
+    LoRa.receive();
+}
+
+#ifdef LINK_CAPTURE
+// RAM2 is otherwise unused, and the capture is only ever touched by the CPU
+DMAMEM static uint8_t link_capture_ring[LINK_CAPTURE_SIZE];
+#endif
+
+DMAMEM static TraceRecord_t event_trace_ring[TRACE_SIZE];
+
+#ifdef PU_SERIAL_DMA
+// the channel wraps the ring with modulo addressing (see SerialDMA.h); a normal
+// global is in DTCM, so the DMA needs no cache maintenance
+static_assert((PU_SERIAL_BUFFER_SIZE & (PU_SERIAL_BUFFER_SIZE - 1)) == 0 && PU_SERIAL_BUFFER_SIZE <= 32768,
+              "PU_SERIAL_BUFFER_SIZE must be a power of two no larger than 32 KB for the DMA ring");
+alignas(PU_SERIAL_BUFFER_SIZE) static uint8_t pu_dma_ring[PU_SERIAL_BUFFER_SIZE];
+#endif
 
 StratoRachuts::StratoRachuts()
     : StratoCore(&ZEPHYR_SERIAL, INSTRUMENT, &DEBUG_SERIAL)
-    , mcbComm(&MCB_SERIAL)
-    , puComm(&PU_SERIAL)
+#ifdef PU_SERIAL_DMA
+    , puDMA(pu_dma_ring, PU_SERIAL_BUFFER_SIZE)
+#endif
+    , mcbFramer(&MCB_SERIAL)
+    , mcbComm(&mcbFramer)
+#ifdef PU_SERIAL_DMA
+    , puFramer(&puDMA)
+#else
+    , puFramer(&PU_SERIAL)
+#endif
+    , puComm(&puFramer)
+    , bufferArena(arena_pool, arena_leases, NUM_ARENA_LEASES)
+    , loraRecords(&blockCRC, RPU_RECORD_BYTES)
+    , loraCommander(&blockCRC)
+#ifdef LINK_CAPTURE
+    , linkCapture(link_capture_ring, LINK_CAPTURE_SIZE)
+#endif
+    , eventTrace(event_trace_ring, TRACE_SIZE)
 {
+    memset(traced_state, 0xFF, sizeof(traced_state));
 }
 
 // --------------------------------------------------------
@@ -58,27 +110,100 @@ void StratoRachuts::InstrumentSetup()
     
     LoRaInit();  //initialize the LoRa modem
 
+    loraQueue.AssignSlots((LoRaPacket_t *) bufferArena.Lease(LEASE_LORA_QUEUE));
+    lora_rx_queue = &loraQueue;
+    loraRecords.AssignBuffer(bufferArena.Lease(LEASE_LORA_TM), LORA_TM_SIZE);
     LoRa.onReceive(onReceive);
+    LoRa.onTxDone(onTxDone);
     LoRa.receive();
 
     if (!pibConfigs.Initialize()) {
-        SendTextTM("Error loading from EEPROM, reloaded default configuration", WARN);
+        SendTextTM(TXT_EEPROM_DEFAULTS, WARN);
     }
 
+    downlinkBudget.SetTotalCap(pibConfigs.downlink_cap.Read());
+    downlinkBudget.SetCap(DL_REPORT, pibConfigs.downlink_cap_report.Read());
+    downlinkBudget.SetCap(DL_MCB, pibConfigs.downlink_cap_mcb.Read(), DOWNLINK_MCB_KEEP);
+
     mcbComm.AssignBinaryRXBuffer(binary_mcb, MCB_BUFFER_SIZE);
-    puComm.AssignBinaryRXBuffer(binary_pu, PU_BUFFER_SIZE);
+    mcbFramer.AssignFrameBuffer(mcb_frame, MCB_FRAME_SIZE);
+    puComm.AssignBinaryRXBuffer(binary_pu, PU_STATUS_SIZE);
+    puFramer.AssignFrameBuffer(pu_frame, PU_FRAME_SIZE);
+#ifdef PU_SERIAL_DMA
+    puDMA.begin(LINK_BASE_BAUD); // takes PU_SERIAL's receive path over from the core driver
+#endif
+#ifdef LINK_CAPTURE
+    mcbFramer.SetCapture(&linkCapture, CAPTURE_MCB);
+    puFramer.SetCapture(&linkCapture, CAPTURE_PU);
+#endif
+
+    for (uint8_t line = 0; bufferArena.Report(line, log_array, LOG_ARRAY_SIZE); line++) {
+        log_nominal(log_array);
+    }
 }
 
 void StratoRachuts::InstrumentLoop()
 {
     WatchFlags();
     LoRaRX();
+    DebugConsole();
+
+    if (inst_substate != traced_substate) {
+        traced_substate = inst_substate;
+        eventTrace.Record(TRACE_SUBSTATE, 0, inst_substate);
+    }
+}
+
+void StratoRachuts::DebugConsole()
+{
+    while (DEBUG_SERIAL.available() > 0) {
+        switch (DEBUG_SERIAL.read()) {
+#ifdef LINK_CAPTURE
+        case 'C':
+            DumpLinkCapture();
+            break;
+        case 'X':
+            linkCapture.Clear();
+            log_nominal("Link capture cleared");
+            break;
+#endif
+        case 'T':
+            DumpEventTrace();
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+#ifdef LINK_CAPTURE
+void StratoRachuts::DumpLinkCapture()
+{
+    uint8_t line[CAPTURE_DUMP_LINE];
+    char hex[2 * CAPTURE_DUMP_LINE + 1];
+    uint32_t offset = 0;
+    uint32_t length = 0;
+
+    // a snapshot: nothing is captured while the dump runs
+    DEBUG_SERIAL.print("CAPTURE ");
+    DEBUG_SERIAL.println(linkCapture.Used());
+
+    while (0 != (length = linkCapture.Read(offset, line, sizeof(line)))) {
+        for (uint32_t i = 0; i < length; i++) {
+            snprintf(hex + 2 * i, 3, "%02X", line[i]);
+        }
+        DEBUG_SERIAL.println(hex);
+        offset += length;
+    }
+
+    DEBUG_SERIAL.println("CAPTURE END");
 }
+#endif
 
 void StratoRachuts::LoRaInit()
 {
    if (!LoRa.begin(FREQUENCY)){
-       SendTextTM("Starting LoRa failed!", WARN);
+       SendTextTM(TXT_LORA_START_FAIL, WARN);
        Serial.println("WARN: LoRa Initializtion Failed");
     }
     delay(1);
@@ -89,55 +214,205 @@ void StratoRachuts::LoRaInit()
     LoRa.setTxPower(RF_POWER);
 }
 
+// Drain every packet queued by onReceive() since the last loop
 void StratoRachuts::LoRaRX()
 {
-    if (PacketSize > 0) {
-        PacketSize = 0;
-        Serial.print("LoRa pkt RSSI:");
-        Serial.println(LoRa.packetRssi());
+    LoRaPacket_t * packet = NULL;
+
+    while (NULL != (packet = loraQueue.Front())) {
+        LOG_DEBUG("LoRa packet: %u bytes, RSSI %d", packet->length, packet->rssi);
+
+        // ACKs for LoRa commands
+        uint8_t msg_id = 0;
+        LoRaCmdResult_t ack = loraCommander.HandleAck(packet->data, packet->length, &msg_id);
+        if (LORA_CMD_ACKED == ack || LORA_CMD_NAKED == ack) {
+            snprintf(log_array, LOG_ARRAY_SIZE, "LoRa: RPU %s command %u", (LORA_CMD_ACKED == ack) ? "ACKed" : "NAKed", msg_id);
+            log_nominal(log_array);
+            if (LORA_CMD_NAKED == ack) {
+                force_rachutsreport = true; // the failure count shows the ground
+                force_report_stats = true;
+            }
+        }
 
-        int BytesToRead = LoRa.available();
-        for (int i = 0; i < BytesToRead; i++)
-            LoRa_RX_buffer[i] = LoRa.read();
+        // profile record fragments are staged for the mode loop to send
+        LoRaFragResult_t frag = FRAG_NONE;
+        if (pibConfigs.lora_tx_tm.Read()) {
+            frag = loraRecords.Add(packet->data, packet->length, packet->rx_ms);
+        }
 
         RPUPacket rpu_packet;
-        if (rpu_packet.decode((const uint8_t*)LoRa_RX_buffer, BytesToRead))
+        if (LORA_CMD_NONE != ack) {
+            // handled above
+        } else if (FRAG_FLUSH_FIRST == frag) {
+            break; // leave it queued until the staged fragments have been sent
+        } else if (FRAG_BAD == frag) {
+            log_error("LoRa RX: bad record fragment");
+        } else if (FRAG_NONE != frag) {
+            // staged, a duplicate, or dropped while offloading (the RPU is docked)
+        } else if (rpu_packet.decode(packet->data, packet->length))
         {
-            String json_str = rpu_packet.toJSON();
-            for (size_t i = 0; i < json_str.length(); i++) {
-                Serial.write(json_str[i]);
-                if (json_str[i] == ',') Serial.println();
-            }
-            Serial.println();
+            LOG_DEBUG("LoRa RPU status captured");
 
             // Capture only -- the mode loops are the single RACHUTSREPORT sender and
             // will incorporate this on their next reporting tick. Sending here
             // (asynchronously, mid-loop) races the mode-loop TM and drops.
-            latest_rpu_json = json_str;
-            latest_rpu_src = "LORA";
-            last_rpu_recv_ms = millis();
-            rpu_ever_received = true;
-            rpu_status_pending = true;
+            if (!rpuStatus.Capture(RPU_SRC_LORA, rpu_packet.toJSON().c_str(), packet->rx_ms, now())) {
+                log_error("LoRa RPU status not captured");
+            }
+
+            // answer to a LoRa status request (TC 143), report it now
+            if (lora_status_requested) {
+                lora_status_requested = false;
+                force_rachutsreport = true;
+            }
         }
         else
         {
-            Serial.println("Failed to decode RPUPacket");
+            LOG_DEBUG("Failed to decode RPUPacket");
         }
+
+        eventTrace.Record(TRACE_LORA_RX, packet->length,
+                          (packet->length >= 2) ? packet->data[0] | (packet->data[1] << 8) : 0);
+        loraStats.Note(packet->rssi, packet->snr, packet->freq_error, !pibConfigs.pu_docked.Read());
+        last_lora_rx_ms = packet->rx_ms;
+#ifdef LINK_CAPTURE
+        // micros() on the Teensy is millis() * 1000 plus the fraction, so this
+        // lines up with the serial records (to the millisecond)
+        linkCapture.Add(CAPTURE_LORA, packet->data, packet->length, packet->rx_ms * 1000UL);
+#endif
+        loraQueue.Pop();
+    }
+
+    CheckLoRaSilence();
+    LoRaCommandTX();
+
+    uint32_t lost = loraQueue.Dropped() + loraQueue.Overflows();
+    if (lost != lora_drop_reported) {
+        snprintf(log_array, LOG_ARRAY_SIZE, "LoRa RX: %lu packets dropped (queue full %lu, oversize %lu)",
+                 (unsigned long) (lost - lora_drop_reported), (unsigned long) loraQueue.Dropped(),
+                 (unsigned long) loraQueue.Overflows());
+        log_error(log_array);
+        lora_drop_reported = lost;
+    }
+}
+
+void StratoRachuts::SetLoRaRate(uint8_t rate)
+{
+    if (rate >= LORA_NUM_RATES) rate = 0;
+    if (rate == lora_rate) return;
+
+    // the modem must be in standby to change settings
+    LoRa.idle();
+    LoRa.setSpreadingFactor(lora_rates[rate].sf);
+    LoRa.setSignalBandwidth(lora_rates[rate].bandwidth);
+    LoRa.receive();
+
+    lora_rate = rate;
+    last_lora_rx_ms = millis();
+
+    snprintf(log_array, LOG_ARRAY_SIZE, "LoRa: SF%u, %lu kHz", lora_rates[rate].sf,
+             (unsigned long) (lora_rates[rate].bandwidth / 1000));
+    log_nominal(log_array);
+}
+
+// Called while docked, before go-measure. The base rate needs no offer: the
+// RPU returns to it on every dock.
+void StratoRachuts::NegotiateLoRaRate()
+{
+    // without ADR the next profile runs at the base rate too
+    if (!pibConfigs.lora_adr.Read()) {
+        if (0 != lora_profile_rate) AgreeLoRaRate(0);
+        return;
+    }
+
+    lora_rate_pending = loraStats.ChooseRate(lora_rates, LORA_NUM_RATES, lora_profile_rate);
+
+    snprintf(log_array, LOG_ARRAY_SIZE, "LoRa ADR: worst SNR %.1f dB over %u packets at SF%u, offering SF%u",
+             loraStats.WindowMinSNR(), loraStats.WindowPackets(), lora_rates[lora_profile_rate].sf,
+             lora_rates[lora_rate_pending].sf);
+    log_nominal(log_array);
+
+    if (0 == lora_rate_pending) {
+        AgreeLoRaRate(0);
+        return;
     }
-    return;
+
+    puFramer.TX_Command(LINK_LORA_RATE, ((uint32_t) lora_rates[lora_rate_pending].sf << 24)
+                                        | lora_rates[lora_rate_pending].bandwidth);
+}
+
+// The rate window restarts so the next choice is judged at this rate
+void StratoRachuts::AgreeLoRaRate(uint8_t rate)
+{
+    lora_profile_rate = rate;
+    loraStats.ResetWindow();
+    SetLoRaRate(rate);
+}
+
+// An RPU that reset mid-profile is back at the base rate
+void StratoRachuts::CheckLoRaSilence()
+{
+    uint32_t silence_ms = 3000UL * pibConfigs.lora_tx_status.Read();
+
+    if (0 == lora_rate || 0 == silence_ms || pibConfigs.pu_docked.Read()) return;
+    if (millis() - last_lora_rx_ms < silence_ms) return;
+
+    lora_rate_fallbacks++;
+    AgreeLoRaRate(0);
+    log_error("LoRa: nothing heard at the negotiated rate, back to base rate");
+}
+
+bool StratoRachuts::SendLoRaCommand(uint8_t msg_id, uint32_t param)
+{
+    if (!pibConfigs.lora_commands.Read() || pibConfigs.pu_docked.Read()) return false;
+
+    if (!loraCommander.Queue(msg_id, param)) {
+        log_error("LoRa command queue full");
+        return false;
+    }
+
+    return true;
+}
+
+// Called from LoRaRX() after the queue is drained. The packet goes out
+// asynchronously and onTxDone() returns the radio to receive; a packet the RPU
+// sends meanwhile is lost (a lost record fragment is left to the dock offload).
+void StratoRachuts::LoRaCommandTX()
+{
+    uint8_t packet[LORA_CMD_SIZE];
+    uint8_t msg_id = 0;
+
+    if (loraCommander.TakeFailed(&msg_id)) {
+        snprintf(log_array, LOG_ARRAY_SIZE, "LoRa: no ACK from RPU for command %u", msg_id);
+        log_error(log_array);
+        force_rachutsreport = true; // the failure count shows the ground
+        force_report_stats = true;
+    }
+
+    uint8_t length = loraCommander.NextPacket(millis(), packet);
+    if (0 == length) return;
+
+    // refused while the last packet is still going out; that counts as an
+    // attempt and the command is resent
+    if (!LoRa.beginPacket()) return;
+
+    LoRa.write(packet, length);
+    LoRa.endPacket(true);
 }
 
 // Send a RACHUTSREPORT TM to the ground. The payload is a JSON object with a
-// "rachuts" header (always present) and, when rpu_block is non-empty, an "rpu"
-// block carrying the decoded RPU status:
+// "rachuts" header (always present) and, when include_rpu is set, an "rpu"
+// block rendered from the RPU status snapshot:
 //   {"rachuts":{...}, "rpu":{...}}
-// A header-only report (empty rpu_block) means no RPU status was available.
-void StratoRachuts::SendRACHUTSREPORT(const String& rpu_block, const String& source)
+// A header-only report means no new RPU status was available.
+void StratoRachuts::SendRACHUTSREPORT(bool include_rpu)
 {
+    const char * source = include_rpu ? rpuStatus.SourceName() : mode_code;
+
     zephyrTX.clearTm();
 
     // StateDetails 2 = "<mode>, <source>" (mode_code tracked per mode function)
-    snprintf(log_array, LOG_ARRAY_SIZE, "%s, %s", mode_code, source.c_str());
+    snprintf(log_array, LOG_ARRAY_SIZE, "%s, %s", mode_code, source);
 
     zephyrTX.setStateDetails(1, "RACHUTSREPORT");
     zephyrTX.setStateDetails(2, log_array);
@@ -148,31 +423,177 @@ void StratoRachuts::SendRACHUTSREPORT(const String& rpu_block, const String& sou
 
     // Seconds since the last RPU status was received (-1 if never), so the ground
     // can gauge staleness even on header-only reports.
-    int32_t rpu_age_s = rpu_ever_received ? (int32_t)((millis() - last_rpu_recv_ms) / 1000UL) : -1;
+    int32_t rpu_age_s = rpuStatus.AgeSeconds(millis());
 
     // epoch = system time in seconds since 1970 (RTC via now(), same as RATSREPORT's
     // header epoch). Unset until the RTC is set from GPS time.
     char header[208];
     snprintf(header, sizeof(header),
              "{\"rachuts\":{\"epoch\":%lu,\"mode\":\"%s\",\"substate\":%u,\"reel\":%.2f,\"src\":\"%s\",\"rpu_age_s\":%ld}",
-             (unsigned long)now(), mode_code, (unsigned)inst_substate, reel_pos, source.c_str(), (long)rpu_age_s);
+             (unsigned long)now(), mode_code, (unsigned)inst_substate, reel_pos, source, (long)rpu_age_s);
 
     String payload(header);
-    if (rpu_block.length() > 0) {
+    AppendReportStats(payload);
+    if (include_rpu) {
+        char rpu_json[RPU_STATUS_JSON_SIZE];
         payload += ",\"rpu\":";
-        payload += rpu_block;
-        rpu_status_pending = false; // this status has now been reported
+        payload += rpuStatus.Render(rpu_json, sizeof(rpu_json)) ? rpu_json : "null";
+        rpuStatus.MarkReported(); // this status has now been reported
     }
     payload += "}";
 
     zephyrTX.addTm((const uint8_t*)payload.c_str(), payload.length());
 
+    SetTMSize(DL_REPORT, payload.length());
     ZephyrTXpoke(ZEPHYRTX_TM);
     zephyrTX.clearTm();
 
     last_rachutsreport_ms = millis();
 }
 
+// The "link" and "dl" blocks, once per REPORT_STATS_PERIOD_S or when a failure
+// they count was flagged (force_report_stats). An unchanged link block is left
+// out; the dl block always changes, if only by the reports themselves.
+void StratoRachuts::AppendReportStats(String & payload)
+{
+    uint32_t now_ms = millis();
+    bool due = force_report_stats || !report_stats_sent
+               || (now_ms - last_report_stats_ms) >= REPORT_STATS_PERIOD_S * 1000UL;
+    if (!due) return;
+
+    String link;
+    AppendLinkStats(link);
+    uint32_t link_crc = blockCRC.Compute((const uint8_t *) link.c_str(), link.length());
+    if (force_report_stats || !report_stats_sent || link_crc != last_link_stats_crc) {
+        payload += link;
+    }
+    AppendDownlinkStats(payload);
+
+    last_link_stats_crc = link_crc;
+    last_report_stats_ms = now_ms;
+    report_stats_sent = true;
+    force_report_stats = false;
+}
+
+// "link" block of the RACHUTSREPORT: bytes of garbage each framer has dropped
+// while resyncing, the number of malformed frames it abandoned, the
+// duplicate/late tagged replies dropped by the correlation tables, the PU
+// baud rate and fallback count, the record CRC counts, the FEC record counts
+// (records, symbols corrected, uncorrectable codewords), and the LoRa receive
+// queue counts (packets, dropped with the queue full, oversize, peak depth),
+// the LoRa record fragment counts (received, bad, discarded unsent, and
+// missing from the current profile), and the LoRa reception statistics (radio
+// settings, fallbacks, mean RSSI/SNR, worst SNR, largest frequency error,
+// fragment loss in per mille, LoRa command packets sent/ACKed/failed, the
+// link capture counts when compiled in (bytes held, data bytes captured,
+// records overwritten, CPU cycles spent capturing), and RSSI/SNR histograms,
+// see LoRaLink.h).
+void StratoRachuts::AppendLinkStats(String & payload)
+{
+    char link[256];
+    snprintf(link, sizeof(link),
+             ",\"link\":{\"pu_skip\":%lu,\"pu_resync\":%lu,\"pu_dup\":%lu,\"pu_late\":%lu,"
+             "\"mcb_skip\":%lu,\"mcb_resync\":%lu,\"mcb_dup\":%lu,\"mcb_late\":%lu",
+             (unsigned long)puFramer.DiscardedBytes(), (unsigned long)puFramer.ResyncCount(),
+             (unsigned long)puSeq.duplicates, (unsigned long)puSeq.late,
+             (unsigned long)mcbFramer.DiscardedBytes(), (unsigned long)mcbFramer.ResyncCount(),
+             (unsigned long)mcbSeq.duplicates, (unsigned long)mcbSeq.late);
+    payload += link;
+
+    snprintf(link, sizeof(link), ",\"pu_baud\":%lu,\"pu_baud_fb\":%lu",
+             (unsigned long)pu_baud, (unsigned long)pu_baud_fallbacks);
+    payload += link;
+
+#ifdef PU_SERIAL_DMA
+    snprintf(link, sizeof(link), ",\"pu_dma_ovr\":%lu,\"pu_dma_err\":%lu",
+             (unsigned long)puDMA.Overruns(), (unsigned long)puDMA.LineErrors());
+    payload += link;
+#endif
+
+    snprintf(link, sizeof(link), ",\"crc_rec\":%lu,\"crc_bad\":%lu,\"crc_fix\":%lu,\"crc_fail\":%lu",
+             (unsigned long)crc_records, (unsigned long)crc_bad_blocks,
+             (unsigned long)crc_repaired, (unsigned long)crc_failed);
+    payload += link;
+
+    snprintf(link, sizeof(link), ",\"fec_rec\":%lu,\"fec_fix\":%lu,\"fec_fail\":%lu",
+             (unsigned long)fec_records, (unsigned long)fec_corrected, (unsigned long)fec_uncorrectable);
+    payload += link;
+
+    snprintf(link, sizeof(link), ",\"lora_rx\":%lu,\"lora_drop\":%lu,\"lora_ovf\":%lu,\"lora_peak\":%u",
+             (unsigned long)loraQueue.Received(), (unsigned long)loraQueue.Dropped(),
+             (unsigned long)loraQueue.Overflows(), loraQueue.HighWater());
+    payload += link;
+
+    snprintf(link, sizeof(link), ",\"lora_frag\":%lu,\"lora_fbad\":%lu,\"lora_fdisc\":%lu,\"lora_gap\":%u",
+             (unsigned long)loraRecords.Fragments(), (unsigned long)loraRecords.Bad(),
+             (unsigned long)loraRecords.Discarded(), loraRecords.Missing());
+    payload += link;
+
+    uint32_t expected = loraRecords.Received() + loraRecords.Missing();
+    snprintf(link, sizeof(link), ",\"lora_sf\":%u,\"lora_bw\":%lu,\"lora_rate_fb\":%lu,\"lora_rssi\":%d,"
+             "\"lora_snr\":%.1f,\"lora_snr_min\":%.1f,\"lora_fe_max\":%lu,\"lora_loss_pm\":%lu",
+             lora_rates[lora_rate].sf, (unsigned long)(lora_rates[lora_rate].bandwidth / 1000),
+             (unsigned long)lora_rate_fallbacks, loraStats.MeanRSSI(), loraStats.MeanSNR(), loraStats.MinSNR(),
+             (unsigned long)loraStats.MaxFreqError(),
+             (unsigned long)(expected ? (1000UL * loraRecords.Missing()) / expected : 0));
+    payload += link;
+
+    snprintf(link, sizeof(link), ",\"lora_cmd_tx\":%lu,\"lora_cmd_ack\":%lu,\"lora_cmd_fail\":%lu",
+             (unsigned long)loraCommander.Sent(), (unsigned long)loraCommander.Acked(),
+             (unsigned long)loraCommander.Failed());
+    payload += link;
+
+#ifdef LINK_CAPTURE
+    snprintf(link, sizeof(link), ",\"cap_used\":%lu,\"cap_bytes\":%lu,\"cap_ovw\":%lu,\"cap_cyc\":%lu",
+             (unsigned long)linkCapture.Used(), (unsigned long)linkCapture.Bytes(),
+             (unsigned long)linkCapture.Overwritten(), (unsigned long)linkCapture.Cycles());
+    payload += link;
+#endif
+
+    AppendHistogram(payload, "lora_rssi_h", loraStats.RSSIHistogram());
+    AppendHistogram(payload, "lora_snr_h", loraStats.SNRHistogram());
+
+    payload += "}";
+}
+
+void StratoRachuts::AppendHistogram(String & payload, const char * name, const uint16_t * bins)
+{
+    char entry[32];
+
+    snprintf(entry, sizeof(entry), ",\"%s\":[", name);
+    payload += entry;
+    for (uint8_t i = 0; i < LORA_HIST_BINS; i++) {
+        snprintf(entry, sizeof(entry), "%s%u", (i > 0) ? "," : "", bins[i]);
+        payload += entry;
+    }
+    payload += "]";
+}
+
+// "dl" block of the RACHUTSREPORT: the total cap and the estimated bytes sent
+// in the last 24 h, then per category the bytes this hour and in the last
+// 24 h and the messages held back by a cap since boot (see DownlinkBudget.h).
+// Counted before this report is sent.
+void StratoRachuts::AppendDownlinkStats(String & payload)
+{
+    char entry[64];
+    uint32_t now_ms = millis();
+
+    snprintf(entry, sizeof(entry), ",\"dl\":{\"cap\":%lu,\"day\":%lu",
+             (unsigned long)pibConfigs.downlink_cap.Read(), (unsigned long)downlinkBudget.WindowTotal(now_ms));
+    payload += entry;
+
+    for (uint8_t i = 0; i < DL_NUM_CATEGORIES; i++) {
+        DownlinkCategory_t category = (DownlinkCategory_t) i;
+        snprintf(entry, sizeof(entry), ",\"%s\":[%lu,%lu,%lu]", DownlinkBudget::CategoryName(category),
+                 (unsigned long)downlinkBudget.HourBytes(category, now_ms),
+                 (unsigned long)downlinkBudget.WindowBytes(category, now_ms),
+                 (unsigned long)downlinkBudget.Refused(category));
+        payload += entry;
+    }
+
+    payload += "}";
+}
+
 // Every-loop RACHUTSREPORT driver for SB/FL/SA/LP. The mode loops are the single
 // sender: once per rpu_status_rate period -- or immediately when a substate sets
 // force_rachutsreport (e.g. a TC 143 status request, which must not be held up by
@@ -184,30 +605,54 @@ void StratoRachuts::SendPeriodicRACHUTSREPORT()
     uint16_t rate = pibConfigs.rpu_status_rate.Read();
     bool period_due = (rate != 0) && ((millis() - last_rachutsreport_ms) >= (uint32_t)rate * 1000UL);
     if (!force_rachutsreport && !period_due) return;
-    force_rachutsreport = false;
 
-    if (rpu_status_pending) {
-        SendRACHUTSREPORT(latest_rpu_json, latest_rpu_src); // clears rpu_status_pending
-    } else {
-        SendRACHUTSREPORT("", mode_code);                   // header-only
+    // over the downlink cap a periodic report waits a period; a new RPU
+    // status stays pending for the next one
+    if (!force_rachutsreport && !downlinkBudget.Allow(DL_REPORT, millis())) {
+        last_rachutsreport_ms = millis();
+        return;
     }
+    force_rachutsreport = false;
+
+    SendRACHUTSREPORT(rpuStatus.Pending()); // header-only unless a new status arrived
 }
 
 // Text TM tagged "RACHUTSTEXT" with the given StateFlag1. Replaces the base
 // ZephyrLog*(), which write the TM directly and so bypass the ZephyrTXpoke()
 // transceiver wake-up.
 void StratoRachuts::SendTextTM(const char * message, StateFlag_t flag)
+{
+    SendTextTM(message, message, flag);
+}
+
+void StratoRachuts::SendTextTM(TextMsg_t id, StateFlag_t flag)
+{
+    char tm_text[TEXT_TM_SIZE];
+    const char * message = TextCatalogString(id);
+    if (NULL == message) message = "";
+
+#ifdef TEXT_CATALOG_TEXT
+    snprintf(tm_text, sizeof(tm_text), "#%u %s", id, message);
+#else
+    snprintf(tm_text, sizeof(tm_text), "#%u", id);
+#endif
+
+    SendTextTM(tm_text, message, flag);
+}
+
+void StratoRachuts::SendTextTM(const char * tm_text, const char * log_text, StateFlag_t flag)
 {
     zephyrTX.clearTm();
     zephyrTX.setStateDetails(1, "RACHUTSTEXT");
-    zephyrTX.setStateDetails(2, message);
+    zephyrTX.setStateDetails(2, tm_text);
     zephyrTX.setStateDetails(3, (String("Reel: ") + String(reel_pos, 2)).c_str());
     zephyrTX.setStateFlagValue(1, flag);
     zephyrTX.setStateFlagValue(2, FINE);
     zephyrTX.setStateFlagValue(3, FINE);
+    SetTMSize(DL_TEXT, strlen(tm_text));
     ZephyrTXpoke(ZEPHYRTX_TM);
     zephyrTX.clearTm();
-    if (flag == FINE) log_nominal(message); else log_error(message);
+    if (flag == FINE) log_nominal(log_text); else log_error(log_text);
 }
 
 // Wake the MAX3381 transceiver with a throwaway byte (absorbing the dropped
@@ -215,6 +660,13 @@ void StratoRachuts::SendTextTM(const char * message, StateFlag_t flag)
 // Zephyr message.
 void StratoRachuts::ZephyrTXpoke(ZephyrTXMsgType_t msg_type)
 {
+    eventTrace.Record(TRACE_TM, (uint8_t) msg_type, 0);
+    if (ZEPHYRTX_TM == msg_type) {
+        downlinkBudget.Note(tm_category, tm_bytes, millis());
+    } else {
+        downlinkBudget.Note(DL_OTHER, DOWNLINK_MSG_BYTES, millis());
+    }
+
     ZEPHYR_SERIAL.write('\n');
     switch (msg_type) {
     case ZEPHYRTX_TM:
@@ -232,6 +684,12 @@ void StratoRachuts::ZephyrTXpoke(ZephyrTXMsgType_t msg_type)
     }
 }
 
+void StratoRachuts::SetTMSize(DownlinkCategory_t category, uint32_t payload_bytes)
+{
+    tm_category = category;
+    tm_bytes = DOWNLINK_TM_OVERHEAD + payload_bytes;
+}
+
 // --------------------------------------------------------
 // Action handler and action flag helper functions
 // --------------------------------------------------------
@@ -244,6 +702,8 @@ void StratoRachuts::ActionHandler(uint8_t action)
         return;
     }
 
+    eventTrace.Record(TRACE_ACTION_FIRE, action, 0);
+
     // set the flag and reset the stale count
     action_flags[action].flag_value = true;
     action_flags[action].stale_count = 0;
@@ -269,6 +729,7 @@ bool StratoRachuts::CheckAction(uint8_t action)
 
 void StratoRachuts::SetAction(uint8_t action)
 {
+    eventTrace.Record(TRACE_ACTION_SET, action, 0);
     action_flags[action].flag_value = true;
     action_flags[action].stale_count = 0;
 }
@@ -297,22 +758,26 @@ bool StratoRachuts::StartMCBMotion()
 
     switch (mcb_motion) {
     case MOTION_REEL_IN:
+        TagMCBRequest(MCB_REEL_IN);
         snprintf(log_array, LOG_ARRAY_SIZE, "Retracting %0.1f revs", retract_length);
         success = mcbComm.TX_Reel_In(retract_length, pibConfigs.retract_velocity.Read());
         max_profile_seconds = 60 * (retract_length / pibConfigs.retract_velocity.Read()) + pibConfigs.motion_timeout.Read();
         break;
     case MOTION_REEL_OUT:
         PUUndock();
+        TagMCBRequest(MCB_REEL_OUT);
         snprintf(log_array, LOG_ARRAY_SIZE, "Deploying %0.1f revs", deploy_length);
         success = mcbComm.TX_Reel_Out(deploy_length, pibConfigs.deploy_velocity.Read());
         max_profile_seconds = 60 * (deploy_length / pibConfigs.deploy_velocity.Read()) + pibConfigs.motion_timeout.Read();
         break;
     case MOTION_DOCK:
+        TagMCBRequest(MCB_DOCK);
         snprintf(log_array, LOG_ARRAY_SIZE, "Docking %0.1f revs", dock_length);
         success = mcbComm.TX_Dock(dock_length, pibConfigs.dock_velocity.Read());
         max_profile_seconds = 60 * (dock_length / pibConfigs.dock_velocity.Read()) + pibConfigs.motion_timeout.Read();
         break;
     case MOTION_IN_NO_LW:
+        TagMCBRequest(MCB_IN_NO_LW);
         snprintf(log_array, LOG_ARRAY_SIZE, "Reel in (no LW) %0.1f revs", retract_length);
         success = mcbComm.TX_In_No_LW(retract_length, pibConfigs.dock_velocity.Read());
         max_profile_seconds = 60 * (retract_length / pibConfigs.dock_velocity.Read()) + pibConfigs.motion_timeout.Read();
@@ -330,12 +795,24 @@ bool StratoRachuts::StartMCBMotion()
 
 void StratoRachuts::AddMCBTM()
 {
+    uint8_t * MCB_TM_buffer = bufferArena.Lease(LEASE_MCB_TM);
+
     // make sure it's the correct size
     if (mcbComm.binary_rx.bin_length != MOTION_TM_SIZE) {
         log_error("invalid motion TM size");
         return;
     }
 
+    // only held while a motion substate runs, and must have room for a sample
+    if (NULL == MCB_TM_buffer) {
+        log_error("motion TM outside a motion");
+        return;
+    }
+    if (MCB_TM_buffer_idx + MOTION_TM_SIZE + 3 > MCB_TM_SIZE) {
+        log_error("motion TM buffer full");
+        return;
+    }
+
     // if not in real-time mode, add the sync and time
     if (!pibConfigs.real_time_mcb.Read()) {
         // sync byte        
@@ -354,7 +831,15 @@ void StratoRachuts::AddMCBTM()
 
     // if real-time mode, send the TM packet
     if (pibConfigs.real_time_mcb.Read()) {
-        snprintf(log_array, LOG_ARRAY_SIZE, "MCB TM Packet %u", ++mcb_tm_counter);
+        // over the downlink cap only one packet in DOWNLINK_MCB_KEEP is sent;
+        // the packet numbers show the gaps
+        mcb_tm_counter++;
+        if (!downlinkBudget.Allow(DL_MCB, millis())) {
+            MCB_TM_buffer_idx = 0;
+            return;
+        }
+
+        snprintf(log_array, LOG_ARRAY_SIZE, "MCB TM Packet %u", mcb_tm_counter);
         zephyrTX.addTm(MCB_TM_buffer,MCB_TM_buffer_idx);
         zephyrTX.setStateDetails(1, log_array);
         zephyrTX.setStateDetails(2, "");
@@ -362,6 +847,7 @@ void StratoRachuts::AddMCBTM()
         zephyrTX.setStateFlagValue(1, FINE);
         zephyrTX.setStateFlagValue(2, NOMESS);
         zephyrTX.setStateFlagValue(3, NOMESS);
+        SetTMSize(DL_MCB, MCB_TM_buffer_idx);
         ZephyrTXpoke(ZEPHYRTX_TM);
         log_nominal(log_array);
         MCB_TM_buffer_idx = 0; //reser the MCB buffer pointer
@@ -378,8 +864,9 @@ void StratoRachuts::NoteProfileStart()
     mcb_tm_counter = 0;
     //zephyrTX.clearTm(); // empty the TM buffer for incoming MCB motion data
     MCB_TM_buffer_idx = 0;
+    uint8_t * MCB_TM_buffer = bufferArena.Lease(LEASE_MCB_TM);
     // Add the start time to the MCB TM Header if not in real-time mode
-    if (!pibConfigs.real_time_mcb.Read()) {
+    if (!pibConfigs.real_time_mcb.Read() && NULL != MCB_TM_buffer) {
         //zephyrTX.addTm((uint32_t) now()); // as a header, add the current seconds since epoch
         uint32_t ProfileStartEpoch  = now();
         MCB_TM_buffer[MCB_TM_buffer_idx++] = (uint8_t) (ProfileStartEpoch >> 24);
@@ -391,10 +878,22 @@ void StratoRachuts::NoteProfileStart()
 
 }
 
+void StratoRachuts::ReportResync(const char * link_name, SerialFramer & framer, uint32_t & reported)
+{
+    if (framer.DiscardedBytes() == reported) return;
+
+    snprintf(log_array, LOG_ARRAY_SIZE, "%s link resync: discarded %lu bytes", link_name,
+             (unsigned long)(framer.DiscardedBytes() - reported));
+    log_nominal(log_array);
+    reported = framer.DiscardedBytes();
+}
+
 void StratoRachuts::SendMCBTM(const char * TMname, StateFlag_t state_flag, const char * message)
 {
+    uint8_t * MCB_TM_buffer = bufferArena.Lease(LEASE_MCB_TM);
+
     zephyrTX.clearTm();
-    zephyrTX.addTm(MCB_TM_buffer, MCB_TM_buffer_idx);
+    if (NULL != MCB_TM_buffer) zephyrTX.addTm(MCB_TM_buffer, MCB_TM_buffer_idx);
 
     // StateMess1 = category tag (MCBACK/MCBASCII/MCBREPORT/MCBSTRING), StateMess2
     // = message, StateMess3 = current reel position.
@@ -408,6 +907,7 @@ void StratoRachuts::SendMCBTM(const char * TMname, StateFlag_t state_flag, const
     zephyrTX.setStateFlagValue(3, FINE);
 
     TM_ack_flag = NO_ACK;
+    SetTMSize(DL_MCB, ((NULL != MCB_TM_buffer) ? MCB_TM_buffer_idx : 0) + strlen(message));
     ZephyrTXpoke(ZEPHYRTX_TM);
 
     if (state_flag == FINE) log_nominal(message); else log_error(message);
@@ -432,6 +932,7 @@ void StratoRachuts::SendMCBEEPROM()
 
     // send as TM
     TM_ack_flag = NO_ACK;
+    SetTMSize(DL_MCB, mcbComm.binary_rx.bin_length);
     ZephyrTXpoke(ZEPHYRTX_TM);
 
     log_nominal("Sent MCB EEPROM as TM");
@@ -461,6 +962,7 @@ void StratoRachuts::SendPIBEEPROM()
 
     // send as TM
     TM_ack_flag = NO_ACK;
+    SetTMSize(DL_OTHER, mcbComm.binary_rx.bin_length);
     ZephyrTXpoke(ZEPHYRTX_TM);
 
     log_nominal("Sent PIB EEPROM as TM");
@@ -468,7 +970,7 @@ void StratoRachuts::SendPIBEEPROM()
 
 void StratoRachuts::SendRPUREPORT(uint8_t packet_num)
 {
-    uint16_t num_records = puComm.binary_rx.bin_length / RPU_RECORD_BYTES;
+    uint16_t num_records = pu_record_length / RPU_RECORD_BYTES;
 
     zephyrTX.setStateDetails(1, "RPUREPORT");
 
@@ -477,9 +979,9 @@ void StratoRachuts::SendRPUREPORT(uint8_t packet_num)
     zephyrTX.setStateDetails(2, log_array);
 
     if (0 < snprintf(log_array, LOG_ARRAY_SIZE, "%lu, %0.4f, %0.4f, %0.1f", 
-        pu_last_status, profile_start_latitude, profile_start_longitude, profile_start_altitude)) {
+        (unsigned long) pu_last_status, profile_start_latitude, profile_start_longitude, profile_start_altitude)) {
         zephyrTX.setStateDetails(3, log_array);
-        zephyrTX.setStateFlagValue(1, FINE);
+        zephyrTX.setStateFlagValue(1, pu_record_valid ? FINE : WARN);
     } else {
         zephyrTX.setStateDetails(3, "PU Profile Record: unable to add status info");
         zephyrTX.setStateFlagValue(1, WARN);
@@ -489,21 +991,283 @@ void StratoRachuts::SendRPUREPORT(uint8_t packet_num)
     zephyrTX.setStateFlagValue(3, FINE);
 
     TM_ack_flag = NO_ACK;
+    SetTMSize(DL_RPU, pu_record_length);
+    ZephyrTXpoke(ZEPHYRTX_TM);
+
+    log_nominal(log_array);
+}
+
+// Binary payload as staged by LoRaRecords: [seq lo][seq hi][count][records]
+// per fragment. The ground places the records by fragment sequence; the
+// missing count says how many fragments the dock offload still has to cover.
+void StratoRachuts::SendLoRaRecordTM(bool force)
+{
+    if (0 == loraRecords.StagedFragments()) return;
+    if (!force && !loraRecords.FlushDue(millis(), LORA_TM_FLUSH_S * 1000UL)) return;
+
+    zephyrTX.clearTm();
+    zephyrTX.addTm(loraRecords.Staged(), loraRecords.StagedLength());
+
+    zephyrTX.setStateDetails(1, "RPULORA");
+
+    snprintf(log_array, LOG_ARRAY_SIZE, "profile:%u fragments:%u records:%u missing:%u",
+             loraRecords.Profile(), loraRecords.StagedFragments(), loraRecords.StagedRecords(),
+             loraRecords.Missing());
+    zephyrTX.setStateDetails(2, log_array);
+
+    char status[64];
+    snprintf(status, sizeof(status), "%lu, %0.4f, %0.4f, %0.1f",
+             (unsigned long) rpuStatus.ReceivedEpoch(), profile_start_latitude, profile_start_longitude, profile_start_altitude);
+    zephyrTX.setStateDetails(3, status);
+
+    zephyrTX.setStateFlagValue(1, FINE);
+    zephyrTX.setStateFlagValue(2, FINE);
+    zephyrTX.setStateFlagValue(3, FINE);
+
+    SetTMSize(DL_RPU, loraRecords.StagedLength());
+    ZephyrTXpoke(ZEPHYRTX_TM);
+    zephyrTX.clearTm();
+
+    log_nominal(log_array);
+    loraRecords.ClearStaged();
+}
+
+// Advisory, so nothing waits for the ACKs. Runs past LORA_HAVE_MAX_RANGES
+// aren't reported, and the RPU offloads those records as usual.
+void StratoRachuts::SendLoRaHave()
+{
+    uint32_t profile = pibConfigs.profile_id.Read() & 0xFF;
+    uint16_t first = 0;
+    uint16_t last = 0;
+    uint8_t ranges = 0;
+
+    if (!pibConfigs.lora_tx_tm.Read() || loraRecords.Profile() != profile) return;
+
+    while (ranges < LORA_HAVE_MAX_RANGES && loraRecords.NextRange(&first, &last)) {
+        puFramer.TX_Command(LINK_LORA_HAVE, (profile << 24) | ((uint32_t) first << 12) | last);
+        ranges++;
+        first = last + 1;
+    }
+
+    if (ranges > 0) {
+        snprintf(log_array, LOG_ARRAY_SIZE, "LoRa: %u fragments of profile %lu already received (%u missing)",
+                 loraRecords.Received(), (unsigned long) profile, loraRecords.Missing());
+        log_nominal(log_array);
+    }
+}
+
+// One JSON TM per offload: {"profile","adaptive","budget","fail_pm","ack_ms",
+// "blocks":[[requested,received,outcome,ack_ms,rx_ms],...],"ms","bytes","Bps",
+// "lost","rx_p":[p50,p90,max],"ack_p":[p50,p90,max]}, where outcome holds the
+// BatchOutcome_t flags (0 = clean). The blocks are the first BATCH_LOG_SIZE,
+// and the percentiles cover those that arrived; ms, bytes, Bps and lost cover
+// the whole offload.
+void StratoRachuts::SendOffloadSummary()
+{
+    uint32_t duration_ms = puBatch.DurationMs(millis());
+    uint32_t total_records = puBatch.Records();
+    uint32_t total_bytes = total_records * RPU_RECORD_BYTES;
+    uint16_t lost_blocks = puBatch.LostBlocks();
+    char entry[96];
+
+    zephyrTX.clearTm();
+
+    snprintf(entry, sizeof(entry), "{\"profile\":%u,\"adaptive\":%u,\"budget\":%u,\"fail_pm\":%u,\"ack_ms\":%lu,\"blocks\":[",
+             pibConfigs.profile_id.Read(), pibConfigs.pu_adaptive_batch.Read() ? 1 : 0, PURecordBudget(),
+             puBatch.FailurePerMille(), (unsigned long)puBatch.AverageAckMs());
+    String payload(entry);
+
+    for (uint8_t i = 0; i < puBatch.Blocks(); i++) {
+        const BatchBlock_t & block = puBatch.Block(i);
+        snprintf(entry, sizeof(entry), "%s[%u,%u,%u,%u,%u]", (i > 0) ? "," : "",
+                 block.requested, block.received, block.outcome, block.ack_ms, block.rx_ms);
+        payload += entry;
+    }
+    payload += "],";
+
+    // throughput over the whole offload, including status checks and baud negotiation
+    snprintf(entry, sizeof(entry), "\"ms\":%lu,\"bytes\":%lu,\"Bps\":%lu,\"lost\":%u,",
+             (unsigned long)duration_ms, (unsigned long)total_bytes,
+             (unsigned long)((duration_ms > 0) ? (uint64_t)total_bytes * 1000 / duration_ms : 0), lost_blocks);
+    payload += entry;
+    snprintf(entry, sizeof(entry), "\"rx_p\":[%u,%u,%u],\"ack_p\":[%u,%u,%u]}",
+             puBatch.RxPercentile(50), puBatch.RxPercentile(90), puBatch.RxPercentile(100),
+             puBatch.AckPercentile(50), puBatch.AckPercentile(90), puBatch.AckPercentile(100));
+    payload += entry;
+
+    snprintf(log_array, LOG_ARRAY_SIZE, "profile:%u blocks:%u records:%lu lost:%u s:%lu",
+             pibConfigs.profile_id.Read(), puBatch.TotalBlocks(), (unsigned long)total_records, lost_blocks,
+             (unsigned long)(duration_ms / 1000));
+
+    zephyrTX.setStateDetails(1, "RPUOFFLOAD");
+    zephyrTX.setStateDetails(2, log_array);
+    zephyrTX.setStateDetails(3, "");
+    zephyrTX.setStateFlagValue(1, (lost_blocks > 0) ? WARN : FINE);
+    zephyrTX.setStateFlagValue(2, FINE);
+    zephyrTX.setStateFlagValue(3, NOMESS);
+
+    zephyrTX.addTm((const uint8_t*)payload.c_str(), payload.length());
+
+    TM_ack_flag = NO_ACK;
+    SetTMSize(DL_RPU, payload.length());
+    ZephyrTXpoke(ZEPHYRTX_TM);
+    zephyrTX.clearTm();
+
+    log_nominal(log_array);
+}
+
+void StratoRachuts::LogPhaseTimeline()
+{
+    char text[96];
+    uint8_t index = 0;
+
+    if (!phaseTimeline.Finish(millis())) return;
+
+    snprintf(log_array, LOG_ARRAY_SIZE, "Timeline %s: %lu ms, %u states, %u dropped",
+             PhaseTimeline::MachineName(phaseTimeline.Top()), (unsigned long) phaseTimeline.ElapsedMs(),
+             phaseTimeline.Count(), phaseTimeline.Dropped());
+    log_nominal(log_array);
+
+    while (index < phaseTimeline.Count()) {
+        uint8_t next = phaseTimeline.Format(index, text, sizeof(text));
+        if (next == index) break;
+        log_nominal(text);
+        index = next;
+    }
+}
+
+void StratoRachuts::NoteState(TimelineMachine_t machine, uint8_t state)
+{
+    if (state != traced_state[machine]) {
+        traced_state[machine] = state;
+        eventTrace.Record(TRACE_STATE, machine, state);
+    }
+
+    phaseTimeline.Note(machine, state, millis());
+}
+
+// Header (little-endian): epoch, millis() and cycle counter at the time of
+// sending, the number of the first event, and the event count; then the
+// events as TraceRecord_t. The header anchors the cycle stamps to real time.
+void StratoRachuts::SendTraceTM()
+{
+    uint8_t header[18];
+    uint16_t count = (eventTrace.Held() < TRACE_TM_EVENTS) ? eventTrace.Held() : TRACE_TM_EVENTS;
+    uint32_t first = eventTrace.Recorded() - count;
+    uint32_t fields[4] = {(uint32_t) now(), millis(), EventTrace::Cycles(), first};
+
+    for (uint8_t i = 0; i < 4; i++) {
+        for (uint8_t b = 0; b < 4; b++) header[4 * i + b] = (uint8_t) (fields[i] >> (8 * b));
+    }
+    header[16] = (uint8_t) count;
+    header[17] = (uint8_t) (count >> 8);
+
+    zephyrTX.clearTm();
+    zephyrTX.addTm(header, sizeof(header));
+    for (uint32_t n = first; n < first + count; n++) {
+        zephyrTX.addTm((const uint8_t *) &eventTrace.At(n), sizeof(TraceRecord_t));
+    }
+
+    snprintf(log_array, LOG_ARRAY_SIZE, "events:%u first:%lu", count, (unsigned long) first);
+
+    zephyrTX.setStateDetails(1, "RACHUTSTRACE");
+    zephyrTX.setStateDetails(2, log_array);
+    zephyrTX.setStateDetails(3, "");
+    zephyrTX.setStateFlagValue(1, FINE);
+    zephyrTX.setStateFlagValue(2, FINE);
+    zephyrTX.setStateFlagValue(3, NOMESS);
+
+    TM_ack_flag = NO_ACK;
+    SetTMSize(DL_OTHER, sizeof(header) + count * sizeof(TraceRecord_t));
     ZephyrTXpoke(ZEPHYRTX_TM);
+    zephyrTX.clearTm();
 
     log_nominal(log_array);
 }
 
+void StratoRachuts::DumpEventTrace()
+{
+    char hex[2 * sizeof(TraceRecord_t) + 1];
+    uint32_t first = eventTrace.Recorded() - eventTrace.Held();
+
+    DEBUG_SERIAL.print("TRACE ");
+    DEBUG_SERIAL.println(eventTrace.Held());
+
+    // one event per line
+    for (uint32_t n = first; n < eventTrace.Recorded(); n++) {
+        const uint8_t * record = (const uint8_t *) &eventTrace.At(n);
+        for (uint8_t i = 0; i < sizeof(TraceRecord_t); i++) {
+            snprintf(hex + 2 * i, 3, "%02X", record[i]);
+        }
+        DEBUG_SERIAL.println(hex);
+    }
+
+    DEBUG_SERIAL.println("TRACE END");
+}
+
+void StratoRachuts::SetArenaPhase(ArenaPhase_t phase)
+{
+    if (phase == bufferArena.Phase()) return;
+
+    // send staged LoRa records before their lease is given up
+    if (!(arena_leases[LEASE_LORA_TM].phases & phase)) SendLoRaRecordTM(true);
+
+    bufferArena.SetPhase(phase);
+    loraRecords.AssignBuffer(bufferArena.Lease(LEASE_LORA_TM), LORA_TM_SIZE);
+
+    // drops any partial frame; records are only requested once the offload
+    // phase has started
+    CancelRecordRepair();
+    uint8_t * record_frame = bufferArena.Lease(LEASE_PU_RECORD);
+    if (NULL != record_frame) {
+        puFramer.AssignFrameBuffer(record_frame, PU_RECORD_FRAME_SIZE);
+    } else {
+        puFramer.AssignFrameBuffer(pu_frame, PU_FRAME_SIZE);
+    }
+}
+
+// The record budget is derived from PU_BUFFER_SIZE here rather than hard-coded
+// on the RPU: a block is RPU_BLOCK_HDR_BYTES plus whole records, and an
+// FEC-coded block loses the header and parity space (assume the strongest code).
+uint16_t StratoRachuts::PURecordBudget()
+{
+    uint32_t payload = PU_BUFFER_SIZE;
+
+    if (pibConfigs.pu_record_fec.Read()) {
+        payload = ((PU_BUFFER_SIZE - FEC_HEADER_SIZE) / RS_BLOCK_SIZE) * FEC_CODEWORD_DATA(RS_MAX_PARITY);
+    }
+
+    // the CRC header is part of the FEC-coded data when both are on, and the
+    // RPU picks the sub-block count, so allow for the most sub-blocks
+    if (pibConfigs.pu_block_crc.Read()) {
+        if (payload <= CRC_HEADER_SIZE(CRC_MAX_SUBBLOCKS)) return 0;
+        payload -= CRC_HEADER_SIZE(CRC_MAX_SUBBLOCKS);
+    }
+
+    if (payload <= RPU_BLOCK_HDR_BYTES) return 0;
+
+    return (payload - RPU_BLOCK_HDR_BYTES) / RPU_RECORD_BYTES;
+}
+
+// Called for every frame from the dock, so only an undocked-to-docked change
+// writes the EEPROM or touches the radio
 void StratoRachuts::PUDock()
 {
-    pibConfigs.pu_docked.Write(true);
     digitalWrite(PU_PWR_ENABLE, HIGH);
+    if (pibConfigs.pu_docked.Read()) return;
+
+    pibConfigs.pu_docked.Write(true);
+
+    // the RPU returns to the base LoRa settings when docked; lora_profile_rate
+    // stays the rate the ADR window was measured at, for NegotiateLoRaRate
+    SetLoRaRate(0);
 }
 
 void StratoRachuts::PUUndock()
 {
     pibConfigs.pu_docked.Write(false);
     digitalWrite(PU_PWR_ENABLE, LOW);
+    SetPUBaud(LINK_BASE_BAUD); // the RPU restarts at the base rate
 }
 
 void StratoRachuts::PUStartProfile()
@@ -514,12 +1278,20 @@ void StratoRachuts::PUStartProfile()
     profile_start_altitude = zephyrRX.zephyr_gps.altitude;
 
     // Enable RPU MEASURE mode with the configured measurement parameters
+    TagPURequest(RPU_GO_MEASURE);
     puComm.TX_GoMeasure(pibConfigs.rpu_meas_duration.Read(), pibConfigs.rpu_meas_rate.Read(),
                         pibConfigs.rpu_bat_temp.Read(),
                         pibConfigs.rpu_enable_ROPC.Read(), pibConfigs.rpu_enable_TDLAS.Read(),
                         pibConfigs.rpu_enable_TSEN.Read(), pibConfigs.rpu_enable_RS41.Read());
 
     pibConfigs.profile_id.Write(pibConfigs.profile_id.Read() + 1);
+
+    // ask the RPU to stream this profile's records over LoRa once undocked
+    if (pibConfigs.lora_tx_tm.Read()) {
+        puFramer.TX_Command(LINK_LORA_STREAM, pibConfigs.profile_id.Read());
+    }
+
+    NegotiateLoRaRate();
 }
 
 void StratoRachuts::ReadAnalog()
@@ -19,6 +19,25 @@
 #include "PIBConfigs.h"
 #include "MCBComm.h"
 #include "RPUComm.h"
+#include "SerialFramer.h"
+#include "LinkSequencer.h"
+#include "ReedSolomon.h"
+#include "CRC32.h"
+#include "BatchSizer.h"
+#include "BufferArena.h"
+#include "LoRaQueue.h"
+#include "LoRaRecords.h"
+#include "LoRaLink.h"
+#include "LoRaCommand.h"
+#include "RPUStatus.h"
+#include "PhaseTimeline.h"
+#include "LinkCapture.h"
+#include "EventTrace.h"
+#include "TextCatalog.h"
+#include "DownlinkBudget.h"
+#ifdef PU_SERIAL_DMA
+#include "SerialDMA.h"
+#endif
 #include "LoRa.h"
 
 #define INSTRUMENT   RACHUTS
@@ -28,6 +47,23 @@
 // framing/checksum) so a full record batch buffers without UART RX overflow.
 #define PU_SERIAL_BUFFER_SIZE     16384
 
+// Debug logging (LOG_DEBUG) is compiled out, formatting and arguments
+// included, unless this is defined; most of it runs every loop
+//#define PIB_DEBUG_LOG
+
+#ifdef PIB_DEBUG_LOG
+#define LOG_DEBUG(...) do { snprintf(log_array, LOG_ARRAY_SIZE, __VA_ARGS__); log_debug(log_array); } while (0)
+#else
+#define LOG_DEBUG(...) do { } while (0)
+#endif
+
+// Catalog RACHUTSTEXT messages (TextCatalog.h) carry only "#<id>" in
+// StateMess2, which text_catalog.py expands on the ground, or "#<id> <text>"
+// if this is defined
+//#define TEXT_CATALOG_TEXT
+
+#define TEXT_TM_SIZE    80
+
 // number of loops before a flag becomes stale and is reset
 #define FLAG_STALE      3
 
@@ -35,10 +71,47 @@
 #define PU_RESEND_TIMEOUT       10
 #define ZEPHYR_RESEND_TIMEOUT   60
 
+// consecutive bad PU frames at a negotiated baud rate before falling back
+#define PU_BAUD_FAIL_BURST      3
+
 #define RETRY_DOCK_LENGTH   2.0f
 
+// reel position within an MCB_MOTION_TM, and the largest magnitude accepted
+#define MOTION_TM_REEL_POS_INDEX    21
+#define REEL_POS_LIMIT              1.0e6f
+
 #define MCB_BUFFER_SIZE     MAX_MCB_BINARY
-#define PU_BUFFER_SIZE      8192
+#define MCB_FRAME_SIZE      (MCB_BUFFER_SIZE + FRAME_OVERHEAD)
+#define PU_BUFFER_SIZE      8192    // largest profile record payload
+#define PU_PATCH_SIZE       2048    // room behind a held record for its repair reply
+#define PU_RECORD_FRAME_SIZE (PU_BUFFER_SIZE + PU_PATCH_SIZE + 2 * FRAME_OVERHEAD)
+#define PU_STATUS_SIZE      1024    // BIN frames other than records (RPU_STATUS)
+#define PU_FRAME_SIZE       (PU_STATUS_SIZE + FRAME_OVERHEAD) // outside offloads
+#define MCB_TM_SIZE         8192    // motion TM accumulated over one motion
+#define CRC_MAX_REPAIRS     2       // sub-block re-requests per record
+
+// Capture every byte received from the MCB, the PU and LoRa to a ring in RAM2
+// (LinkCapture.h), dumped with 'C' on the debug port; comment out to compile
+// the capture out
+#define LINK_CAPTURE
+#define LINK_CAPTURE_SIZE   65536
+#define CAPTURE_DUMP_LINE   32      // bytes per hex line of a dump
+
+// Event trace ring in RAM2 (EventTrace.h), and the most recent events sent in
+// a RACHUTSTRACE TM
+#define TRACE_SIZE          4096    // power of two
+#define TRACE_TM_EVENTS     256
+
+// Estimated Zephyr bytes per message for the downlink budget (DownlinkBudget.h):
+// XML framing and state fields of a TM on top of its payload, and a whole
+// non-TM message
+#define DOWNLINK_TM_OVERHEAD    240
+#define DOWNLINK_MSG_BYTES      96
+#define DOWNLINK_MCB_KEEP       10      // real-time MCB TMs sent one in this many over the cap
+
+// The "link" and "dl" blocks (about 1 KB) ride in a RACHUTSREPORT at most this
+// often, and the link block only when it has changed since it was last sent
+#define REPORT_STATS_PERIOD_S   900
 
 //LoRa Settings
 #define FREQUENCY 868E6
@@ -46,6 +119,51 @@
 #define SF 9
 #define RF_POWER 19
 #define LORA_TM_TIMEOUT 600
+#define LORA_TM_SIZE    2048    // LoRa record fragments staged for one TM
+#define LORA_TM_FLUSH_S 60      // longest a staged fragment waits for its TM
+#define LORA_HAVE_MAX_RANGES 16 // received-fragment runs reported before an offload
+
+// LoRa settings the adaptive data rate steps through, slowest first; the
+// first entry is the base setting both ends start at (see LINK_LORA_RATE)
+constexpr LoRaRate_t lora_rates[] = {
+    {SF, (uint32_t) BANDWIDTH},
+    {8, 250000},
+    {7, 250000},
+    {7, 500000},
+};
+#define LORA_NUM_RATES  (sizeof(lora_rates) / sizeof(lora_rates[0]))
+
+// Working buffers shared through bufferArena (BufferArena.h), in the order of
+// ArenaLeaseID_t. The LoRa lease is live in every phase so it's placed first.
+enum ArenaLeaseID_t : uint8_t {
+    LEASE_LORA_QUEUE,   // LoRaQueue slots, filled from the receive interrupt
+    LEASE_MCB_TM,
+    LEASE_LORA_TM,      // LoRa record fragments staged for the next TM
+    LEASE_PU_RECORD,    // PU frame buffer big enough for record blocks
+    LEASE_FEC_GROUP,    // de-interleaved FEC codewords
+    NUM_ARENA_LEASES
+};
+
+constexpr ArenaLease_t arena_leases[NUM_ARENA_LEASES] = {
+    {"lora_queue",  LORA_QUEUE_DEPTH * sizeof(LoRaPacket_t), ARENA_ALL_PHASES},
+    {"mcb_tm",      MCB_TM_SIZE,                        ARENA_MOTION},
+    {"lora_tm",     LORA_TM_SIZE,                       ARENA_IDLE | ARENA_MOTION},
+    {"pu_record",   PU_RECORD_FRAME_SIZE,               ARENA_OFFLOAD},
+    {"fec_group",   FEC_MAX_DEPTH * RS_BLOCK_SIZE,      ARENA_OFFLOAD},
+};
+
+// Worst-case concurrent footprint. Growing it is a deliberate decision: check
+// the RAM1 headroom in the build output and raise ARENA_BUDGET to match.
+#define ARENA_SIZE      ArenaFootprint(arena_leases, NUM_ARENA_LEASES, ARENA_ALL_PHASES)
+#define ARENA_BUDGET    16384
+static_assert(ARENA_SIZE <= ARENA_BUDGET, "buffer arena exceeds ARENA_BUDGET");
+
+// result of an end-to-end record check
+enum RecordCheck_t : uint8_t {
+    RECORD_OK,
+    RECORD_CORRUPT,     // forward anyway, flagged
+    RECORD_REPAIRING,   // damaged sub-blocks re-requested, wait for the reply
+};
 
 // todo: update naming to be more unique (ie. ACT_ prefix)
 enum ScheduleAction_t : uint8_t {
@@ -63,6 +181,7 @@ enum ScheduleAction_t : uint8_t {
     RESEND_PU_WARMUP,
     RESEND_PU_GOPROFILE,
     RESEND_FULL_RETRACT,
+    RESEND_PU_BAUD,
 
     // exit the error state (ground command only)
     EXIT_ERROR_STATE,
@@ -124,9 +243,16 @@ public:
     void RunPURouter();
     void LoRaRX();
     void LoRaInit();
-    // Build and send a RACHUTSREPORT TM: a "rachuts" header (always present) plus
-    // an "rpu" block when rpu_block is non-empty. Records the transmission time.
-    void SendRACHUTSREPORT(const String& rpu_block, const String& source);
+
+    // single-character commands on the debug port: 'C' dumps the link
+    // capture, 'X' clears it, 'T' dumps the event trace
+    void DebugConsole();
+
+    // Build and send a RACHUTSREPORT TM: a "rachuts" header (always present), the
+    // "link" and "dl" blocks when due (REPORT_STATS_PERIOD_S), plus an "rpu" block rendered from rpuStatus when include_rpu is set (null if
+    // it doesn't fit the render buffer). Records
+    // the transmission time.
+    void SendRACHUTSREPORT(bool include_rpu);
 
     // Called every loop in SB/FL/SA/LP: if a full rpu_status_rate period has
     // elapsed with no RACHUTSREPORT sent, transmit a header-only RACHUTSREPORT.
@@ -137,17 +263,87 @@ public:
     // ZephyrTXpoke() so the transceiver is woken first, and it also logs locally.
     void SendTextTM(const char * message, StateFlag_t flag);
 
+    // The same for a fixed message from the catalog, sent by its ID
+    void SendTextTM(TextMsg_t id, StateFlag_t flag);
+
+    // Send tm_text as the RACHUTSTEXT message and log log_text locally
+    void SendTextTM(const char * tm_text, const char * log_text, StateFlag_t flag);
+
     // Wake up the MAX3381 serial transceiver by sending a blank character to
     // ZEPHYR_SERIAL before calling the specified ZephyrTX member function. The
     // MAX3381 has a 30-second inactivity timeout, after which it powers down and
     // can drop the first transmitted byte.
     void ZephyrTXpoke(ZephyrTXMsgType_t msg_type);
 
+    // Category and payload size of the TM being built, counted against the
+    // downlink budget by ZephyrTXpoke(); a resend counts again
+    void SetTMSize(DownlinkCategory_t category, uint32_t payload_bytes);
+
 private:
-    // internal serial interface objects for the MCB and PU
+    // internal serial interface objects for the MCB and PU; each framer must
+    // precede the interface that reads through it
+#ifdef PU_SERIAL_DMA
+    SerialDMA puDMA;
+#endif
+    SerialFramer mcbFramer;
     MCBComm mcbComm;
+    SerialFramer puFramer;
     RPUComm puComm;
 
+    // request/reply correlation for sequence-tagged requests
+    LinkSequencer mcbSeq;
+    LinkSequencer puSeq;
+
+    // Reed-Solomon codec for FEC-coded profile records
+    ReedSolomon recordFEC;
+
+    // CRC-32 for end-to-end record block checks
+    CRC32 blockCRC;
+
+    // record-batch sizing and per-block log for PU offloads
+    BatchSizer puBatch;
+
+    // large working buffers, shared between flight phases
+    alignas(ARENA_ALIGN) uint8_t arena_pool[ARENA_SIZE];
+    BufferArena bufferArena;
+
+    // received LoRa packets, queued by onReceive() and drained by LoRaRX()
+    LoRaQueue loraQueue;
+    uint32_t lora_drop_reported = 0;
+
+    // profile records streamed over LoRa while undocked, staged for TM
+    LoRaRecords loraRecords;
+
+    // LoRa reception statistics and adaptive data rate
+    LoRaLinkStats loraStats;
+    uint8_t lora_rate = 0;              // index into lora_rates the radio is using
+    uint8_t lora_profile_rate = 0;      // rate agreed for undocked profiles
+    uint8_t lora_rate_pending = 0;      // rate offered with LINK_LORA_RATE, awaiting the ACK
+    uint32_t lora_rate_fallbacks = 0;   // returns to the base rate on silence
+    uint32_t last_lora_rx_ms = 0;       // millis() of the last packet, or of the last rate change
+
+    // commands to the undocked RPU over LoRa
+    LoRaCommander loraCommander;
+    bool lora_status_requested = false; // report the next LoRa status at once
+
+    // states visited during the current profile, redock or offload run
+    PhaseTimeline phaseTimeline;
+
+    // binary trace of state changes, actions, messages, TMs and TCs
+    EventTrace eventTrace;
+    uint8_t traced_state[TL_NUM_MACHINES];
+    uint8_t traced_substate = 0xFF;
+
+#ifdef LINK_CAPTURE
+    // received bytes on every instrument link, in RAM2
+    LinkCapture linkCapture;
+#endif
+
+    // Zephyr bytes sent per TM category, and the caps on them
+    DownlinkBudget downlinkBudget;
+    DownlinkCategory_t tm_category = DL_OTHER;
+    uint32_t tm_bytes = 0;
+
     // EEPROM interface object
     PIBConfigs pibConfigs;
 
@@ -170,6 +366,7 @@ private:
     bool Flight_PUOffload(bool restart_state);
     bool Flight_ManualMotion(bool restart_state);
     bool Flight_DockedProfile(bool restart_state);
+    bool Flight_PUBaud(bool restart_state);
 
     // Telcommand handler - returns ack/nak
     bool TCHandler(Telecommand_t telecommand);
@@ -197,13 +394,41 @@ private:
     void HandleMCBBin();
     void HandleMCBString();
     uint8_t binary_mcb[MCB_BUFFER_SIZE];
+    uint8_t mcb_frame[MCB_FRAME_SIZE];
 
     // Handle messages from the PU (in PURouter.cpp)
     void HandlePUASCII();
     void HandlePUAck();
     void HandlePUBin();
     void HandlePUString();
-    uint8_t binary_pu[PU_BUFFER_SIZE];
+    uint8_t binary_pu[PU_STATUS_SIZE];
+    uint8_t pu_frame[PU_FRAME_SIZE];
+
+    // Move bufferArena to a new phase; the PU framer switches to the record
+    // frame lease during offloads and to pu_frame otherwise
+    void SetArenaPhase(ArenaPhase_t phase);
+
+    // payload of the in-place record frame being dispatched, and the record
+    // being handled (the same frame, or a block held for repair); both point
+    // into the PU frame buffer
+    uint8_t * pu_frame_payload = NULL;
+    uint8_t * pu_record = NULL;
+
+    // Decode an FEC-coded profile record in place at pu_record, setting
+    // record_length to the recovered data length. Returns false if the header
+    // is invalid or any codeword was uncorrectable (data is still recovered
+    // as far as possible).
+    bool DecodeFECRecord(uint16_t * record_length);
+
+    // Profile record handling, including the end-to-end CRC check and
+    // sub-block repair (the block is held in pu_frame while the repair reply
+    // is received behind it)
+    void HandlePURecord();
+    RecordCheck_t CheckRecordCRC(uint16_t * record_offset, uint16_t * record_length);
+    RecordCheck_t ApplyRecordRepair(const uint8_t * patch);
+    void RequestRecordRepair();
+    void CancelRecordRepair();
+    static uint32_t ReadCRC(const uint8_t * field);
 
     // Start any type of MCB motion
     bool StartMCBMotion();
@@ -214,6 +439,34 @@ private:
     // Set variables and TM buffer after a profile starts
     void NoteProfileStart();
 
+    // Tag an outgoing request with a sequence number if tagging is enabled for
+    // the link; call immediately before sending the request
+    void TagMCBRequest(uint8_t request_id);
+    void TagPURequest(uint8_t request_id);
+
+    // Correlate a tagged reply with its request (untagged replies always pass);
+    // returns false for duplicate and late replies, which should be dropped
+    bool AcceptMCBReply(SerialMessage_t rx_msg);
+    bool AcceptPUReply(SerialMessage_t rx_msg);
+
+    // PU dock-link baud rate control (in Flight_PUBaud.cpp)
+    void SetPUBaud(uint32_t baud);
+    void PUBaudFallback(const char * reason);
+    void NotePUFrame(bool valid); // falls back after a burst of bad frames
+
+    // Log any garbage a framer has dropped since the last call
+    void ReportResync(const char * link_name, SerialFramer & framer, uint32_t & reported);
+
+    // Append the "link" and "dl" blocks to a RACHUTSREPORT payload when due
+    void AppendReportStats(String & payload);
+
+    // Append the "link" block (serial link statistics) to a RACHUTSREPORT payload
+    void AppendLinkStats(String & payload);
+    void AppendHistogram(String & payload, const char * name, const uint16_t * bins);
+
+    // Append the "dl" block (downlink bytes per category) to a RACHUTSREPORT payload
+    void AppendDownlinkStats(String & payload);
+
     // Send a telemetry packet with MCB binary info
     void SendMCBTM(const char * TMname, StateFlag_t state_flag, const char * message);
 
@@ -223,7 +476,57 @@ private:
 
     void SendRPUREPORT(uint8_t packet_num);
 
-    // call every time the known state of the PU changes
+    // Send the staged LoRa record fragments as an RPULORA TM when due (or
+    // now, if force); call only from the mode loops
+    void SendLoRaRecordTM(bool force);
+
+    // Tell the RPU which LoRa fragments of the current profile were received
+    void SendLoRaHave();
+
+    // LoRa adaptive data rate: retune the radio, offer the RPU the rate for the
+    // next profile, and fall back to the base rate on silence
+    void SetLoRaRate(uint8_t rate);
+    void NegotiateLoRaRate();
+    void AgreeLoRaRate(uint8_t rate);
+    void CheckLoRaSilence();
+
+    // Queue a command to the undocked RPU over LoRa; false if LoRa commands
+    // are disabled, the RPU is docked, or the queue is full. LoRaCommandTX()
+    // sends what's due and reports failures.
+    bool SendLoRaCommand(uint8_t msg_id, uint32_t param);
+    void LoRaCommandTX();
+
+    // rpu_bat_temp as the RPU_GO_STANDBY LoRa parameter (hundredths of a degree)
+    uint32_t LoRaBatTemp() { return (uint32_t) (int32_t) lroundf(pibConfigs.rpu_bat_temp.Read() * 100.0f); }
+
+    // Send the per-block size and outcome summary at the end of a PU offload
+    void SendOffloadSummary();
+
+    // End the phase timeline run, if any, and log it to the debug port
+    void LogPhaseTimeline();
+
+    // Called by each flight state machine with its current state: feeds the
+    // phase timeline and traces changes
+    void NoteState(TimelineMachine_t machine, uint8_t state);
+
+    // Send the most recent events (up to TRACE_TM_EVENTS) as a RACHUTSTRACE
+    // TM, or write the whole trace to the debug port as hex lines between
+    // "TRACE <events>" and "TRACE END"
+    void SendTraceTM();
+    void DumpEventTrace();
+
+#ifdef LINK_CAPTURE
+    // Write the link capture, oldest first, to the debug port as hex lines
+    // between "CAPTURE <bytes>" and "CAPTURE END"
+    void DumpLinkCapture();
+#endif
+
+    // Largest record batch that fits PU_BUFFER_SIZE in the current link mode,
+    // after the FEC coding and the worst-case CRC header
+    uint16_t PURecordBudget();
+
+    // call every time the known state of the PU changes (PUDock acts only on
+    // the change from undocked)
     void PUDock();
     void PUUndock();
 
@@ -276,35 +579,58 @@ private:
     uint16_t docked_profile_time = 0;
     uint16_t docked_profile_rate = 0;
 
+    // discarded-byte counts already logged by ReportResync
+    uint32_t mcb_discard_reported = 0;
+    uint32_t pu_discard_reported = 0;
+
+    // FEC record statistics since boot
+    uint32_t fec_records = 0;           // FEC-coded records received
+    uint32_t fec_corrected = 0;         // symbols corrected
+    uint32_t fec_uncorrectable = 0;     // codewords beyond correction
+
+    // end-to-end record CRC statistics since boot, and repair state
+    uint32_t crc_records = 0;           // CRC-checked records received
+    uint32_t crc_bad_blocks = 0;        // records with at least one bad sub-block
+    uint32_t crc_repaired = 0;          // sub-blocks repaired by re-request
+    uint32_t crc_failed = 0;            // records forwarded with the CRC still failing
+    uint32_t crc_repair_mask = 0;       // sub-blocks awaiting repair, 0 = none
+    uint8_t crc_repair_tries = 0;
+    uint16_t crc_data_offset = 0;       // record data within pu_record
+    uint16_t crc_data_length = 0;
+
+    // the last profile record forwarded (data within pu_record, valid until
+    // the next RunPURouter())
+    uint16_t pu_record_offset = 0;
+    uint16_t pu_record_length = 0;
+    bool pu_record_valid = true;
+
+    // PU dock-link baud rate
+    uint32_t pu_baud = LINK_BASE_BAUD;  // rate PU_SERIAL is currently running at
+    uint32_t pu_baud_fallbacks = 0;     // fallbacks to the base rate since boot
+    uint8_t pu_bad_frames = 0;          // consecutive rejected/bad-checksum frames
+    bool pu_baud_acked = false;         // set in PURouter when the RPU ACKs LINK_SET_BAUD
+    bool pu_baud_naked = false;         // set in PURouter when the RPU NAKs LINK_SET_BAUD
+
     // array of error values for MCB motion fault
     uint16_t motion_fault[8] = {0};
-    uint8_t MCB_TM_buffer[8192] = {0};
-    uint16_t MCB_TM_buffer_idx = 0;
+    uint16_t MCB_TM_buffer_idx = 0;     // fill of the LEASE_MCB_TM buffer
 
     // PU status information
-    uint32_t pu_last_status = 0;        // RACHUTS-local time of last received RPU status
-    String pu_status_json;              // raw JSON status string from RPU
+    RPUStatus rpuStatus;                // most recent RPU status (LoRa or dock)
+    uint32_t pu_last_status = 0;        // RACHUTS-local time of last received dock RPU status
     bool pu_status_received = false;    // set when a fresh RPU_STATUS is received, cleared by Flight_CheckPU
 
     // RACHUTSREPORT reporting cadence (see SendPeriodicRACHUTSREPORT)
     uint32_t last_rachutsreport_ms = 0;     // millis() of last RACHUTSREPORT TM sent (any source)
-    uint32_t last_rpu_recv_ms = 0;      // millis() of last RPU status received (LoRa or dock)
-    bool rpu_ever_received = false;     // set once any RPU status has been received
-    String latest_rpu_json;             // most recent captured RPU status (LoRa or dock)
-    String latest_rpu_src;              // origin of latest_rpu_json ("LORA" / "DOCK")
-    bool rpu_status_pending = false;    // captured status not yet included in a report
     bool force_rachutsreport = false;       // request an immediate RACHUTSREPORT on the next mode loop
-
-    uint8_t eeprom_buffer[256];
+    bool force_report_stats = false;        // include the link and dl blocks in the next RACHUTSREPORT
+    bool report_stats_sent = false;         // the link and dl blocks have been sent since boot
+    uint32_t last_report_stats_ms = 0;      // millis() they were last sent
+    uint32_t last_link_stats_crc = 0;       // CRC-32 of the link block last sent
 
     //Variables for LoRa TMs and Status strings
     bool Send_LoRa_TM = true;
     bool Send_LoRa_status = true;
-    char LoRa_RX_buffer[256] = {0};
-    char LoRa_PU_status[256] = {0};
-    
-    uint8_t LoRa_TM_buffer[8192] = {0};
-    uint16_t LoRa_TM_buffer_idx = 0;
     uint16_t pu_tm_counter = 0;
     long LoRa_rx_time = 0;
 
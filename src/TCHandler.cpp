@@ -33,6 +33,8 @@ bool StratoRachuts::TCHandler(Telecommand_t telecommand)
     // Deferred actions that send their own TM (run after the ack TM).
     bool send_pib_eeprom = false;
 
+    eventTrace.Record(TRACE_TC, 0, telecommand);
+
     switch (telecommand) {
 
     // MCB Telecommands -----------------------------------
@@ -183,6 +185,11 @@ bool StratoRachuts::TCHandler(Telecommand_t telecommand)
     case GETPUSTATUS:
         msg2 = "TC Get PU Status";
         if (!RequireFlightMode("Get PU status", msg3, msg1_flag)) break;
+        if (SendLoRaCommand(RPU_SEND_STATUS, 0)) {
+            msg3 = "Requested over LoRa";
+            lora_status_requested = true;
+            break;
+        }
         SetAction(ACTION_CHECK_PU);
         break;
     case PUPOWERON:
@@ -234,6 +241,8 @@ bool StratoRachuts::TCHandler(Telecommand_t telecommand)
             msg3 = "Motion ongoing, request RACHuTS EEPROM later";
             msg1_flag = WARN;
         } else {
+            // the event trace rides along: there is no TC of its own
+            msg3 = "With event trace";
             send_pib_eeprom = true;
         }
         break;
@@ -271,6 +280,7 @@ bool StratoRachuts::TCHandler(Telecommand_t telecommand)
     case CANCELMEASURE:
         msg2 = "TC Cancel Measure";
         puComm.TX_GoStandby(pibConfigs.rpu_bat_temp.Read()); // no matter what, attempt to send (irrespective of mode)
+        if (SendLoRaCommand(RPU_GO_STANDBY, LoRaBatTemp())) msg3 = "Also sent over LoRa";
         SetAction(ACTION_CANCEL_MEASURE);
         break;
 
@@ -296,15 +306,19 @@ bool StratoRachuts::TCHandler(Telecommand_t telecommand)
              + " TDLAS=" + String(pibConfigs.rpu_enable_TDLAS.Read())
              + " TSEN=" + String(pibConfigs.rpu_enable_TSEN.Read())
              + " RS41=" + String(pibConfigs.rpu_enable_RS41.Read());
+        // an undocked RPU can change its rate mid-profile; the rest applies from the next go-measure
+        if (SendLoRaCommand(LINK_SET_MEAS_RATE, pibConfigs.rpu_meas_rate.Read())) msg3 = "Rate sent over LoRa";
         break;
     case RPUSTATUSPERIOD:
         pibConfigs.rpu_status_rate.Write(rpuParam.statusPeriodSecs);
         puComm.TX_SetStatusRate(pibConfigs.rpu_status_rate.Read());
+        if (SendLoRaCommand(RPU_SET_STATUS_RATE, pibConfigs.rpu_status_rate.Read())) msg3 = "Sent over LoRa";
         msg2 = "Set rpu_status_rate: " + String(pibConfigs.rpu_status_rate.Read());
         break;
     case RPUGOSTANDBY:
         msg2 = "Sent go-standby to RPU";
         puComm.TX_GoStandby(pibConfigs.rpu_bat_temp.Read());
+        if (SendLoRaCommand(RPU_GO_STANDBY, LoRaBatTemp())) msg3 = "Sent over LoRa";
         break;
     case RPUGOMEASURE:
         // Duration and rate come from the TC parameters; battery setpoint and
@@ -344,6 +358,7 @@ bool StratoRachuts::TCHandler(Telecommand_t telecommand)
     zephyrTX.setStateFlagValue(3, FINE);
 
     TM_ack_flag = NO_ACK;
+    SetTMSize(DL_TCACK, msg2.length() + msg3.length());
     ZephyrTXpoke(ZEPHYRTX_TM);
 
     // Log the TC summary message
@@ -356,12 +371,13 @@ bool StratoRachuts::TCHandler(Telecommand_t telecommand)
         log_error(msg2.c_str());
         break;
     default:
-        log_debug(msg2.c_str());
+        log_nominal(msg2.c_str());
     }
 
     // Deferred actions that send their own TM (run after the ack TM)
     if (send_pib_eeprom) {
         SendPIBEEPROM();
+        SendTraceTM();
     }
 
     return true;
@@ -0,0 +1,19 @@
+/*
+ *  TextCatalog.cpp
+ *  Created: October 2026
+ *
+ *  This file implements the RACHUTSTEXT message lookup.
+ */
+
+#include "TextCatalog.h"
+
+#define TEXT_CATALOG_CASE(id, name, text) case name: return text;
+
+const char * TextCatalogString(TextMsg_t id)
+{
+    switch (id) {
+    TEXT_CATALOG(TEXT_CATALOG_CASE)
+    default:
+        return NULL;
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ *  TextCatalog.h
+ *  Created: October 2026
+ *
+ *  Stable numeric IDs for the fixed RACHUTSTEXT messages. TEXT_CATALOG is the
+ *  one list of them: the enum and the string table are built from it here,
+ *  and text_catalog.py reads it to expand IDs in received TMs and to generate
+ *  the message inventory in docs/RachutsTMInventory.md.
+ *
+ *  An ID is never reused or renumbered once flown; retire a message by
+ *  leaving its line in place. Messages built with snprintf are not in the
+ *  catalog and are sent as text.
+ */
+
+#ifndef TEXTCATALOG_H
+#define TEXTCATALOG_H
+
+#include "Arduino.h"
+
+//  X(id, name, text)
+#define TEXT_CATALOG(X) \
+    X(1,  TXT_FLIGHT_ERROR,         "Entered flight error state") \
+    X(2,  TXT_PU_NO_STATUS,         "PU not responding to status request") \
+    X(3,  TXT_RPU_NO_GO_MEASURE,    "RPU not responding to go-measure command") \
+    X(4,  TXT_DOCKED_CANCELLED,     "Docked profile cancelled") \
+    X(5,  TXT_DOCKED_FINISHED,      "Finished docked profile") \
+    X(6,  TXT_RA_NAK,               "Cannot perform motion, RA NAK") \
+    X(7,  TXT_NO_RA_ACK,            "Never received RAAck") \
+    X(8,  TXT_MOTION_ONGOING,       "Motion commanded while motion ongoing") \
+    X(9,  TXT_MOTION_START_ERROR,   "Motion start error") \
+    X(10, TXT_MOTION_UNCONFIRMED,   "MCB never confirmed motion") \
+    X(11, TXT_MOTION_STOP,          "Commanded motion stop") \
+    X(12, TXT_MOTION_STOP_AUTO,     "Commanded motion stop in autonomous") \
+    X(13, TXT_OFFLOAD_RECORD_FAIL,  "PU not successful in sending profile record") \
+    X(14, TXT_NO_DOCK,              "No dock! Exceeded allowable number of redock attempts") \
+    X(15, TXT_DWELL_SCHEDULE,       "Unable to schedule dwell") \
+    X(16, TXT_MCB_NOT_OFF,          "MCB never powered off after profile") \
+    X(17, TXT_RPU_NAK_GO_MEASURE,   "RPU NAKed go-measure command") \
+    X(18, TXT_RPU_NAK_GO_STANDBY,   "RPU NAKed go-standby command") \
+    X(19, TXT_RPU_ACK_RESET,        "RPU acked reset") \
+    X(20, TXT_EEPROM_DEFAULTS,      "Error loading from EEPROM, reloaded default configuration") \
+    X(21, TXT_LORA_START_FAIL,      "Starting LoRa failed!")
+
+#define TEXT_CATALOG_ENUM(id, name, text) name = id,
+
+enum TextMsg_t : uint8_t {
+    TXT_NONE = 0,
+    TEXT_CATALOG(TEXT_CATALOG_ENUM)
+};
+
+// The message for an ID, or NULL for one not in the catalog
+const char * TextCatalogString(TextMsg_t id);
+
+#endif /* TEXTCATALOG_H */
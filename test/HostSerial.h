@@ -0,0 +1,37 @@
+/*
+ *  HostSerial.h
+ *  Created: October 2026
+ *
+ *  A stand-in serial port for the host tests: bytes fed in are read back
+ *  through the Stream interface, and everything written is kept in tx.
+ */
+
+#ifndef HOSTSERIAL_H
+#define HOSTSERIAL_H
+
+#include "Arduino.h"
+#include <deque>
+#include <string>
+
+class HostSerial : public Stream {
+public:
+    void Feed(const std::string & bytes) { rx.insert(rx.end(), bytes.begin(), bytes.end()); }
+    void Feed(const uint8_t * bytes, size_t length) { rx.insert(rx.end(), bytes, bytes + length); }
+
+    int available() { return (int) rx.size(); }
+    int read()
+    {
+        if (rx.empty()) return -1;
+        int c = rx.front();
+        rx.pop_front();
+        return c;
+    }
+    int peek() { return rx.empty() ? -1 : rx.front(); }
+    size_t write(uint8_t b) { tx.push_back((char) b); return 1; }
+    using Print::write;
+
+    std::deque<uint8_t> rx;
+    std::string tx;
+};
+
+#endif /* HOSTSERIAL_H */
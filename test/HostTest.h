@@ -0,0 +1,40 @@
+/*
+ *  HostTest.h
+ *  Created: October 2026
+ *
+ *  Minimal checks for the host tests: each failed CHECK prints its location
+ *  and is counted, and HOST_TEST_RESULT() turns the count into the exit code
+ *  that ctest reads.
+ */
+
+#ifndef HOSTTEST_H
+#define HOSTTEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+static int host_test_failures = 0;
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+        host_test_failures++; \
+    } } while (0)
+
+#define HOST_TEST_RESULT() (printf("%s\n", host_test_failures ? "FAIL" : "ok"), host_test_failures ? 1 : 0)
+
+// Deterministic pseudo-random bytes, so a failure reproduces on any host
+struct HostRandom {
+    uint32_t state;
+    explicit HostRandom(uint32_t seed) : state(seed ? seed : 1) { }
+    uint32_t Next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+    uint32_t Below(uint32_t limit) { return Next() % limit; }
+};
+
+#endif /* HOSTTEST_H */
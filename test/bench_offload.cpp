@@ -0,0 +1,162 @@
+/*
+ *  bench_offload.cpp
+ *  Created: October 2026
+ *
+ *  Offload throughput benchmark on the virtual clock: an RPU model answers
+ *  each BatchSizer request with a BIN record frame over a dock link of a
+ *  given baud rate and byte error rate, SerialFramer assembles it, a corrupt
+ *  or missing frame is re-requested, and each block waits a modelled Zephyr
+ *  TM ack latency. Prints blocks/s, bytes/s, the rx/ack percentiles and lost
+ *  blocks per scenario, and fails if a scenario's record throughput drops
+ *  below its threshold.
+ *
+ *  The thresholds sit about 15% under the throughput measured when they were
+ *  set; a change that moves them either way should update them here.
+ */
+
+#include "HostTest.h"
+#include "HostSerial.h"
+#include "BatchSizer.h"
+#include "SerialFramer.h"
+#include <string>
+
+#define BENCH_RECORD_BYTES      48      // RPU_RECORD_BYTES
+#define BENCH_BLOCK_HDR_BYTES   32      // RPU_BLOCK_HDR_BYTES
+#define BENCH_BUDGET            170     // PURecordBudget() for an 8 KB record, plain
+#define BENCH_RECORDS           6000    // records in the simulated profile
+#define BENCH_RETRIES           2       // re-requests before a block counts as lost
+#define BENCH_TIMEOUT_MS        2000    // wait for a block before re-requesting it
+#define BENCH_TURNAROUND_MS     20      // request bytes plus RPU processing
+#define BENCH_CHUNK             256     // bytes delivered to the framer per poll
+
+struct BenchScenario_t {
+    const char * name;
+    uint32_t baud;
+    double byte_error_rate;
+    uint32_t ack_ms;            // mean Zephyr TM ack latency
+    bool adaptive;
+    uint32_t min_bps;           // record bytes per second, regression threshold
+};
+
+static const BenchScenario_t scenarios[] = {
+    {"clean 460k, fast acks",   460800, 0,      1000,  true,  5200},
+    {"clean 460k, slow acks",   460800, 0,      25000, true,  36},
+    {"noisy 460k (1e-5)",       460800, 1e-5,   1000,  true,  4580},
+    {"noisy 460k (1e-4)",       460800, 1e-4,   1000,  true,  1430},
+    {"noisy 460k (1e-4) fixed", 460800, 1e-4,   1000,  false, 4420},
+    {"clean 115k, fast acks",   115200, 0,      1000,  true,  3730},
+};
+
+static uint8_t frame_buffer[BENCH_BUDGET * BENCH_RECORD_BYTES + BENCH_BLOCK_HDR_BYTES + FRAME_OVERHEAD];
+
+// a BIN frame as the RPU sends it; the checksum covers everything from the
+// start character through the terminator in front of it
+static std::string RecordFrame(HostRandom & random, uint16_t records)
+{
+    std::string payload(BENCH_BLOCK_HDR_BYTES + records * BENCH_RECORD_BYTES, '\0');
+    for (char & c : payload) c = (char) random.Next();
+
+    std::string frame = "!1," + std::to_string(payload.size()) + ";" + payload + ";";
+    uint8_t check_a = 0;
+    uint8_t check_b = 0;
+    for (char c : frame) {
+        check_a += (uint8_t) c;
+        check_b += check_a;
+    }
+    return frame + std::to_string(((uint16_t) check_a << 8) | check_b) + ";";
+}
+
+// Send one frame over the link, byte errors and all, and poll the framer as
+// it arrives. True if it came through with a valid checksum.
+static bool Transfer(HostRandom & random, const BenchScenario_t & scenario, HostSerial & link,
+                     SerialFramer & framer, std::string frame, bool * framed)
+{
+    uint32_t error_threshold = (uint32_t) (scenario.byte_error_rate * 4294967295.0);
+    for (char & c : frame) {
+        if (error_threshold > 0 && random.Next() < error_threshold) c ^= (char) (1 + random.Below(255));
+    }
+
+    *framed = false;
+    bool valid = false;
+    for (size_t offset = 0; offset < frame.size(); offset += BENCH_CHUNK) {
+        size_t count = (frame.size() - offset < BENCH_CHUNK) ? frame.size() - offset : BENCH_CHUNK;
+        link.Feed((const uint8_t *) frame.data() + offset, count);
+        HostAdvanceUs(count * 10ULL * 1000000ULL / scenario.baud);
+
+        while (framer.Poll()) {
+            uint8_t id;
+            uint8_t * payload;
+            uint16_t length;
+            bool checksum_valid;
+            if (framer.BinaryFrame(&id, &payload, &length, &checksum_valid)) {
+                *framed = true;
+                valid = checksum_valid;
+            }
+        }
+    }
+    return valid;
+}
+
+static bool RunScenario(const BenchScenario_t & scenario)
+{
+    HostRandom random(43);
+    HostSerial link;
+    SerialFramer framer(&link);
+    BatchSizer sizer;
+
+    framer.AssignFrameBuffer(frame_buffer, sizeof(frame_buffer));
+    sizer.StartOffload(BENCH_BUDGET, scenario.adaptive, millis());
+
+    uint32_t remaining = BENCH_RECORDS;
+    while (remaining > 0) {
+        uint16_t records = sizer.Next();
+        if (records > remaining) records = (uint16_t) remaining;
+
+        sizer.BeginBlock(millis());
+        bool received = false;
+        for (uint8_t attempt = 0; attempt <= BENCH_RETRIES && !received; attempt++) {
+            if (attempt > 0) sizer.NoteRetry();
+            HostAdvanceMs(BENCH_TURNAROUND_MS);
+
+            bool framed;
+            received = Transfer(random, scenario, link, framer, RecordFrame(random, records), &framed);
+            if (framed && !received) {
+                sizer.NoteCorrupt();
+            } else if (!framed) {
+                HostAdvanceMs(BENCH_TIMEOUT_MS); // nothing recognisable arrived
+            }
+        }
+
+        if (!received) {
+            sizer.LostBlock();
+            continue;
+        }
+
+        sizer.Received(records, millis());
+        remaining -= records;
+
+        // ack latency varies +-50% around the mean
+        uint32_t ack_ms = scenario.ack_ms / 2 + random.Below(scenario.ack_ms + 1);
+        HostAdvanceMs(ack_ms);
+        sizer.EndBlock(ack_ms, true);
+    }
+
+    uint32_t duration_ms = sizer.DurationMs(millis());
+    uint32_t bytes = sizer.Records() * BENCH_RECORD_BYTES;
+    uint32_t bps = (uint32_t) ((uint64_t) bytes * 1000 / (duration_ms ? duration_ms : 1));
+    bool pass = bps >= scenario.min_bps;
+
+    printf("%-26s %7.2f blocks/s %7lu B/s (min %lu) rx_p %u/%u/%u ack_p %u/%u/%u lost %u  %s\n",
+           scenario.name, sizer.TotalBlocks() * 1000.0 / (duration_ms ? duration_ms : 1),
+           (unsigned long) bps, (unsigned long) scenario.min_bps,
+           sizer.RxPercentile(50), sizer.RxPercentile(90), sizer.RxPercentile(100),
+           sizer.AckPercentile(50), sizer.AckPercentile(90), sizer.AckPercentile(100),
+           sizer.LostBlocks(), pass ? "" : "BELOW THRESHOLD");
+    return pass;
+}
+
+int main()
+{
+    for (const BenchScenario_t & scenario : scenarios) CHECK(RunScenario(scenario));
+    return HOST_TEST_RESULT();
+}
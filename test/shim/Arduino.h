@@ -0,0 +1,71 @@
+/*
+ *  Arduino.h
+ *  Created: October 2026
+ *
+ *  The part of the Arduino/Teensy core that the host-portable modules use,
+ *  for building them on a workstation (see test/CMakeLists.txt). Time comes
+ *  from a virtual clock that only moves when a test advances it.
+ *
+ *  Print and Stream mirror the Teensy core: write(uint8_t) and the Stream
+ *  reads are virtual, readBytes() is not.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// the virtual clock, in microseconds since "boot"
+inline uint64_t & HostClockUs()
+{
+    static uint64_t clock_us = 0;
+    return clock_us;
+}
+
+inline void HostAdvanceUs(uint64_t us) { HostClockUs() += us; }
+inline void HostAdvanceMs(uint32_t ms) { HostClockUs() += (uint64_t) ms * 1000; }
+
+inline uint32_t micros() { return (uint32_t) HostClockUs(); }
+inline uint32_t millis() { return (uint32_t) (HostClockUs() / 1000); }
+
+class Print {
+public:
+    virtual ~Print() { };
+    virtual size_t write(uint8_t b) = 0;
+    virtual size_t write(const uint8_t * buffer, size_t size)
+    {
+        size_t count = 0;
+        while (size--) count += write(*buffer++);
+        return count;
+    }
+    size_t write(const char * str) { return write((const uint8_t *) str, strlen(str)); }
+    virtual void flush() { };
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    // the core waits up to a timeout for each byte; the host has nothing to
+    // wait for, so this stops at the first missing byte
+    size_t readBytes(char * buffer, size_t length)
+    {
+        size_t count = 0;
+        while (count < length) {
+            int c = read();
+            if (c < 0) break;
+            *buffer++ = (char) c;
+            count++;
+        }
+        return count;
+    }
+};
+
+#endif /* HOST_ARDUINO_H */
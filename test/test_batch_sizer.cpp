@@ -0,0 +1,160 @@
+/*
+ *  test_batch_sizer.cpp
+ *  Created: October 2026
+ *
+ *  BatchSizer: growth on clean fast blocks, halving on failures, shrinking
+ *  on slow TM acks, the budget and minimum, offload totals and nearest-rank
+ *  percentiles.
+ */
+
+#include "HostTest.h"
+#include "BatchSizer.h"
+
+static void CleanBlock(BatchSizer & sizer, uint32_t * now_ms, uint32_t rx_ms, uint32_t ack_ms)
+{
+    sizer.BeginBlock(*now_ms);
+    *now_ms += rx_ms;
+    sizer.Received(sizer.Next(), *now_ms);
+    sizer.EndBlock(ack_ms, true);
+}
+
+static void TestAdapt()
+{
+    BatchSizer sizer;
+    uint32_t now_ms = 1000;
+
+    sizer.StartOffload(200, true, now_ms);
+    CHECK(BATCH_START_RECORDS == sizer.Next());
+
+    // clean blocks with prompt acks grow the batch up to the budget
+    CleanBlock(sizer, &now_ms, 500, 1000);
+    CHECK(BATCH_START_RECORDS + BATCH_STEP == sizer.Next());
+    for (int i = 0; i < 10; i++) CleanBlock(sizer, &now_ms, 500, 1000);
+    CHECK(200 == sizer.Next());
+
+    // a corrupt block halves it
+    sizer.BeginBlock(now_ms);
+    sizer.NoteCorrupt();
+    sizer.Received(200, now_ms + 500);
+    sizer.EndBlock(1000, true);
+    CHECK(100 == sizer.Next());
+
+    // a lost block halves it again, never below the minimum
+    for (int i = 0; i < 5; i++) {
+        sizer.BeginBlock(now_ms);
+        sizer.LostBlock();
+    }
+    CHECK(BATCH_MIN_RECORDS == sizer.Next());
+
+    // slow TM acks shrink it instead of growing it
+    BatchSizer slow;
+    slow.StartOffload(500, true, 0);
+    now_ms = 0;
+    CleanBlock(slow, &now_ms, 500, BATCH_ACK_SLOW_MS * 2);
+    CHECK(BATCH_START_RECORDS - BATCH_STEP == slow.Next());
+
+    // when not adaptive the batch never moves
+    BatchSizer fixed;
+    fixed.StartOffload(500, false, 0);
+    fixed.BeginBlock(0);
+    fixed.LostBlock();
+    CHECK(BATCH_START_RECORDS == fixed.Next());
+
+    // a budget below the start size caps the first request
+    BatchSizer small;
+    small.StartOffload(50, true, 0);
+    CHECK(50 == small.Next());
+}
+
+static void TestTotals()
+{
+    BatchSizer sizer;
+    uint32_t now_ms = 1000;
+    sizer.StartOffload(170, false, now_ms);
+
+    for (int i = 0; i < 10; i++) {
+        sizer.BeginBlock(now_ms);
+        now_ms += 100 * (i + 1);
+        sizer.Received(100, now_ms);
+        sizer.EndBlock(50 * (10 - i), true);
+    }
+    sizer.BeginBlock(now_ms);
+    sizer.LostBlock();
+
+    CHECK(11 == sizer.Blocks() && 11 == sizer.TotalBlocks());
+    CHECK(1000 == sizer.Records());
+    CHECK(1 == sizer.LostBlocks());
+    CHECK(BATCH_LOST == sizer.Block(10).outcome);
+    CHECK(now_ms + 5 - 1000 == sizer.DurationMs(now_ms + 5));
+
+    // the lost block has no timings and is left out of the percentiles
+    CHECK(100 == sizer.RxPercentile(0));
+    CHECK(1000 == sizer.RxPercentile(100));
+    CHECK(50 == sizer.AckPercentile(0));
+    CHECK(500 == sizer.AckPercentile(100));
+
+    // totals keep counting past the logged blocks
+    for (int i = 0; i < BATCH_LOG_SIZE + 36; i++) {
+        sizer.BeginBlock(now_ms);
+        sizer.Received(10, now_ms + 1);
+        sizer.EndBlock(1, true);
+    }
+    CHECK(BATCH_LOG_SIZE == sizer.Blocks());
+    CHECK(11 + BATCH_LOG_SIZE + 36 == sizer.TotalBlocks());
+    CHECK(1000 + 10 * (BATCH_LOG_SIZE + 36) == sizer.Records());
+
+    BatchSizer empty;
+    CHECK(0 == empty.RxPercentile(50));
+}
+
+// nearest rank: the value at rank ceil(p * n / 100), counting from 1
+static void TestPercentiles()
+{
+    BatchSizer sizer;
+    uint32_t now_ms = 0;
+    sizer.StartOffload(170, false, now_ms);
+
+    for (int i = 1; i <= 4; i++) {
+        sizer.BeginBlock(now_ms);
+        sizer.Received(10, now_ms + 10 * i);
+        sizer.EndBlock(100 * (5 - i), true);
+    }
+
+    // rx 10, 20, 30, 40
+    CHECK(10 == sizer.RxPercentile(0));
+    CHECK(10 == sizer.RxPercentile(25));
+    CHECK(20 == sizer.RxPercentile(26));
+    CHECK(20 == sizer.RxPercentile(50));
+    CHECK(40 == sizer.RxPercentile(90));    // rank 4; truncating (n - 1) * p gave 30
+    CHECK(40 == sizer.RxPercentile(100));
+    CHECK(40 == sizer.RxPercentile(200));
+    CHECK(200 == sizer.AckPercentile(50));
+
+    // a single block is every percentile
+    BatchSizer one;
+    one.StartOffload(170, false, 0);
+    one.BeginBlock(0);
+    one.Received(10, 7);
+    one.EndBlock(3, true);
+    CHECK(7 == one.RxPercentile(0) && 7 == one.RxPercentile(50) && 7 == one.RxPercentile(100));
+
+    // a full log of 1..BATCH_LOG_SIZE
+    BatchSizer full;
+    full.StartOffload(170, false, 0);
+    for (int i = BATCH_LOG_SIZE; i >= 1; i--) {
+        full.BeginBlock(0);
+        full.Received(10, i);
+        full.EndBlock(1, true);
+    }
+    CHECK(32 == full.RxPercentile(50));
+    CHECK(58 == full.RxPercentile(90));     // ceil(57.6)
+    CHECK(64 == full.RxPercentile(100));
+}
+
+int main()
+{
+    TestAdapt();
+    TestTotals();
+    TestPercentiles();
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,60 @@
+/*
+ *  test_buffer_arena.cpp
+ *  Created: October 2026
+ *
+ *  BufferArena: the compile-time layout, and leases given out only in their
+ *  phases.
+ */
+
+#include "HostTest.h"
+#include "BufferArena.h"
+
+constexpr ArenaLease_t leases[] = {
+    {"lora_rx",   256,  ARENA_ALL_PHASES},
+    {"mcb_tm",    8192, ARENA_MOTION},
+    {"pu_record", 10303, ARENA_OFFLOAD},
+    {"fec_group", 2040, ARENA_OFFLOAD},
+    {"staging",   1000, ARENA_IDLE | ARENA_MOTION},
+};
+
+constexpr uint8_t num_leases = sizeof(leases) / sizeof(leases[0]);
+
+// leases sharing a phase never overlap; the others reuse the same memory
+static_assert(ArenaOffset(leases, 0) == 0, "first lease at the start");
+static_assert(ArenaOffset(leases, 1) == 256, "after lora_rx");
+static_assert(ArenaOffset(leases, 2) == 256, "shares memory with mcb_tm");
+static_assert(ArenaOffset(leases, 3) == 256 + 10304, "after pu_record, aligned");
+static_assert(ArenaOffset(leases, 4) == 256 + 8192, "after mcb_tm");
+static_assert(ArenaFootprint(leases, num_leases, ARENA_ALL_PHASES) == 256 + 10304 + 2040, "worst case");
+static_assert(ArenaFootprint(leases, num_leases, ARENA_IDLE) == 256 + 8192 + 1000, "idle");
+
+alignas(ARENA_ALIGN) static uint8_t pool[ArenaFootprint(leases, num_leases, ARENA_ALL_PHASES)];
+
+int main()
+{
+    BufferArena arena(pool, leases, num_leases);
+
+    CHECK(ARENA_IDLE == arena.Phase());
+    CHECK(pool == arena.Lease(0));
+    CHECK(NULL == arena.Lease(1));
+    CHECK(pool + 256 + 8192 == arena.Lease(4));
+
+    arena.SetPhase(ARENA_MOTION);
+    CHECK(pool + 256 == arena.Lease(1));
+    CHECK(NULL == arena.Lease(2));
+
+    arena.SetPhase(ARENA_OFFLOAD);
+    CHECK(pool + 256 == arena.Lease(2));
+    CHECK(pool + 256 + 10304 == arena.Lease(3));
+    CHECK(NULL == arena.Lease(4));
+    CHECK(NULL == arena.Lease(num_leases));
+    CHECK(2040 == arena.LeaseSize(3));
+    CHECK(0 == arena.LeaseSize(num_leases));
+
+    char line[128];
+    uint8_t lines = 0;
+    while (arena.Report(lines, line, sizeof(line))) lines++;
+    CHECK(num_leases + 1 == lines);
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,55 @@
+/*
+ *  test_crc32.cpp
+ *  Created: October 2026
+ *
+ *  CRC32: the standard check value, and the sliced tables against a
+ *  bit-at-a-time reference over every length and alignment mix.
+ */
+
+#include "HostTest.h"
+#include "CRC32.h"
+
+static uint32_t Reference(const uint8_t * data, uint32_t length)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    while (length--) {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+
+    return ~crc;
+}
+
+static CRC32 crc;
+static uint8_t data[9000];
+
+int main()
+{
+    HostRandom random(32);
+
+    CHECK(0xCBF43926 == crc.Compute((const uint8_t *) "123456789", 9));
+    CHECK(0 == crc.Compute(data, 0));
+
+    for (uint32_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t) random.Next();
+
+    for (uint32_t length = 0; length < 64; length++) {
+        for (uint32_t offset = 0; offset < 8; offset++) {
+            CHECK(Reference(data + offset, length) == crc.Compute(data + offset, length));
+        }
+    }
+
+    for (int i = 0; i < 200; i++) {
+        uint32_t offset = random.Below(100);
+        uint32_t length = random.Below(8000);
+        CHECK(Reference(data + offset, length) == crc.Compute(data + offset, length));
+
+        // a running CRC over two pieces matches the whole
+        uint32_t split = random.Below(length + 1);
+        uint32_t running = crc.Update(0xFFFFFFFF, data + offset, split);
+        running = crc.Update(running, data + offset + split, length - split);
+        CHECK(crc.Compute(data + offset, length) == ~running);
+    }
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,57 @@
+/*
+ *  test_downlink_budget.cpp
+ *  Created: October 2026
+ *
+ *  DownlinkBudget: hourly bins rolling out of the window, caps with
+ *  decimation, the total cap, and millis() wrap-around.
+ */
+
+#include "HostTest.h"
+#include "DownlinkBudget.h"
+#include <string>
+
+int main()
+{
+    DownlinkBudget budget;
+    const uint32_t hour = DOWNLINK_BIN_MS;
+
+    budget.Note(DL_MCB, 100, 0);
+    budget.Note(DL_TEXT, 50, 10);
+    CHECK(150 == budget.WindowTotal(20));
+    CHECK(budget.Allow(DL_MCB, 20));
+
+    // over the cap, one request in four still goes
+    budget.SetCap(DL_MCB, 100, 4);
+    int allowed = 0;
+    for (int i = 0; i < 8; i++) allowed += budget.Allow(DL_MCB, 30);
+    CHECK(2 == allowed);
+    CHECK(6 == budget.Refused(DL_MCB));
+
+    CHECK(0 == budget.HourBytes(DL_MCB, hour + 5));
+    CHECK(100 == budget.WindowBytes(DL_MCB, hour + 5));
+    budget.Note(DL_MCB, 7, hour + 5);
+    CHECK(107 == budget.WindowBytes(DL_MCB, 23 * hour + 1));
+
+    // the first hour rolls out, then the second
+    CHECK(7 == budget.WindowBytes(DL_MCB, 24 * hour + 1));
+    CHECK(0 == budget.WindowBytes(DL_MCB, 25 * hour + 1));
+    CHECK(budget.Allow(DL_MCB, 25 * hour + 1));
+    CHECK(107 == budget.Bytes(DL_MCB));
+
+    // the total cap holds back every category
+    budget.SetTotalCap(10);
+    budget.Note(DL_TEXT, 20, 26 * hour);
+    CHECK(!budget.Allow(DL_REPORT, 26 * hour));
+
+    // a gap longer than the window empties it
+    CHECK(0 == budget.WindowTotal(126 * hour));
+
+    // millis() wrapping
+    DownlinkBudget wrap;
+    wrap.Note(DL_RPU, 5, 0xFFFFFFF0u);
+    CHECK(5 == wrap.WindowBytes(DL_RPU, 0xFFFFFFF0u + 100));
+
+    CHECK(std::string("tcack") == DownlinkBudget::CategoryName(DL_TCACK));
+
+    return HOST_TEST_RESULT();
+}
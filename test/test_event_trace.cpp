@@ -0,0 +1,41 @@
+/*
+ *  test_event_trace.cpp
+ *  Created: October 2026
+ *
+ *  EventTrace: a mark ahead of the first event and once per interval, and
+ *  the ring keeping the newest events.
+ */
+
+#include "HostTest.h"
+#include "EventTrace.h"
+
+static TraceRecord_t ring[16];
+
+int main()
+{
+    EventTrace trace(ring, 16);
+    CHECK(0 == trace.Held());
+
+    HostAdvanceMs(0x123456);
+    trace.Record(TRACE_TC, 0, 143);
+    CHECK(2 == trace.Recorded());
+    CHECK(TRACE_MARK == trace.At(0).event);
+    CHECK(0x12 == trace.At(0).id && 0x3456 == trace.At(0).value);
+    CHECK(TRACE_TC == trace.At(1).event && 143 == trace.At(1).value);
+
+    // no new mark within the interval
+    HostAdvanceMs(TRACE_MARK_MS - 1);
+    trace.Record(TRACE_STATE, 1, 2);
+    CHECK(3 == trace.Recorded());
+
+    HostAdvanceMs(1);
+    trace.Record(TRACE_STATE, 1, 3);
+    CHECK(5 == trace.Recorded());
+    CHECK(TRACE_MARK == trace.At(3).event);
+
+    for (int i = 0; i < 40; i++) trace.Record(TRACE_STATE, 1, (uint16_t) i);
+    CHECK(16 == trace.Held());
+    CHECK(39 == trace.At(trace.Recorded() - 1).value);
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,56 @@
+/*
+ *  test_link_capture.cpp
+ *  Created: October 2026
+ *
+ *  LinkCapture: long reads split into records, wrap-around overwriting whole
+ *  records, and reads from an offset.
+ */
+
+#include "HostTest.h"
+#include "LinkCapture.h"
+
+static uint8_t ring[1000];
+
+int main()
+{
+    LinkCapture capture(ring, sizeof(ring));
+    uint8_t data[600];
+    uint8_t out[1000];
+
+    for (int i = 0; i < 600; i++) data[i] = (uint8_t) i;
+
+    // 255 + 255 + 90 bytes
+    capture.Add(CAPTURE_PU, data, 600, 12345);
+    CHECK(600 + 3 * CAPTURE_HEADER_SIZE == capture.Used());
+    CHECK(600 == capture.Bytes());
+
+    uint32_t length = capture.Read(0, out, sizeof(out));
+    CHECK(capture.Used() == length);
+    CHECK(CAPTURE_PU == out[0] && 255 == out[1]);
+    CHECK((12345 & 0xFF) == out[2] && (12345 >> 8) == out[3]);
+    CHECK(0 == memcmp(out + CAPTURE_HEADER_SIZE, data, 255));
+
+    // wrap around several times; what is left must still parse as records
+    for (int k = 0; k < 50; k++) {
+        capture.Add((CaptureLink_t) (k % 3), data + k, 1 + (k * 37) % 300, k);
+    }
+    CHECK(capture.Overwritten() > 0);
+
+    length = capture.Read(0, out, sizeof(out));
+    uint32_t offset = 0;
+    while (offset < length) {
+        CHECK(out[offset] <= CAPTURE_LORA);
+        CHECK(out[offset + 1] > 0);
+        offset += CAPTURE_HEADER_SIZE + out[offset + 1];
+    }
+    CHECK(offset == length);
+
+    uint8_t tail[10];
+    CHECK(3 == capture.Read(length - 3, tail, sizeof(tail)));
+    CHECK(0 == capture.Read(length, tail, sizeof(tail)));
+
+    capture.Clear();
+    CHECK(0 == capture.Used());
+
+    return HOST_TEST_RESULT();
+}
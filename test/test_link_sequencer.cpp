@@ -0,0 +1,43 @@
+/*
+ *  test_link_sequencer.cpp
+ *  Created: October 2026
+ *
+ *  LinkSequencer: matched, duplicate, late, mismatched and unsolicited
+ *  replies, and expiry of the oldest request when the table is full.
+ */
+
+#include "HostTest.h"
+#include "LinkSequencer.h"
+
+int main()
+{
+    LinkSequencer sequencer;
+
+    uint8_t first = sequencer.Open(10, 0);
+    uint8_t second = sequencer.Open(11, 5);
+    CHECK(first != second);
+
+    CHECK(SEQ_MATCHED == sequencer.Match(first, 10));
+    CHECK(SEQ_DUPLICATE == sequencer.Match(first, 10));
+
+    // the second request times out before its reply arrives
+    sequencer.Expire(20000, 10000);
+    CHECK(SEQ_LATE == sequencer.Match(second, 11));
+
+    uint8_t third = sequencer.Open(12, 30000);
+    CHECK(SEQ_MISMATCHED == sequencer.Match(third, 13));
+    CHECK(SEQ_UNSOLICITED == sequencer.Match((uint8_t) (third + 100), 12));
+
+    CHECK(1 == sequencer.matched);
+    CHECK(1 == sequencer.duplicates);
+    CHECK(1 == sequencer.late);
+    CHECK(2 == sequencer.unsolicited);
+
+    // a full table expires its oldest request to make room
+    LinkSequencer full;
+    uint8_t oldest = full.Open(1, 0);
+    for (int i = 1; i <= SEQ_MAX_OUTSTANDING; i++) full.Open(1, i);
+    CHECK(SEQ_LATE == full.Match(oldest, 1));
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,86 @@
+/*
+ *  test_lora_command.cpp
+ *  Created: October 2026
+ *
+ *  LoRaCommander: queueing and replacement, the packet format, ACK and NAK
+ *  matching, retries, and the failure report.
+ */
+
+#include "HostTest.h"
+#include "LoRaCommand.h"
+
+static CRC32 crc;
+
+static void Ack(uint8_t * packet, uint8_t seq, uint8_t msg_id, uint8_t ack)
+{
+    packet[0] = LORA_CMD_MAGIC_0;
+    packet[1] = LORA_ACK_MAGIC_1;
+    packet[2] = seq;
+    packet[3] = msg_id;
+    packet[4] = ack;
+
+    uint32_t check = crc.Compute(packet, 5);
+    for (int i = 0; i < 4; i++) packet[5 + i] = (uint8_t) (check >> (8 * i));
+}
+
+int main()
+{
+    LoRaCommander commander(&crc);
+    uint8_t packet[LORA_CMD_SIZE];
+    uint8_t ack[LORA_ACK_SIZE];
+    uint8_t msg_id = 0;
+
+    CHECK(0 == commander.NextPacket(0, packet));
+
+    // the second command for id 10 replaces the first
+    CHECK(commander.Queue(10, 5));
+    CHECK(commander.Queue(11, 7));
+    CHECK(commander.Queue(10, 6));
+
+    CHECK(LORA_CMD_SIZE == commander.NextPacket(0, packet));
+    CHECK(LORA_CMD_MAGIC_0 == packet[0] && LORA_CMD_MAGIC_1 == packet[1]);
+    CHECK(10 == packet[3] && 6 == packet[4] && 2 == packet[2]);
+    uint32_t check = crc.Compute(packet, 8);
+    CHECK(packet[8] == (uint8_t) check && packet[11] == (uint8_t) (check >> 24));
+
+    CHECK(LORA_CMD_SIZE == commander.NextPacket(0, packet));
+    CHECK(11 == packet[3] && 1 == packet[2]);
+
+    // nothing more is due until the retry interval
+    CHECK(0 == commander.NextPacket(100, packet));
+
+    Ack(ack, 2, 10, 1);
+    CHECK(LORA_CMD_ACKED == commander.HandleAck(ack, LORA_ACK_SIZE, &msg_id) && 10 == msg_id);
+    CHECK(LORA_CMD_STALE == commander.HandleAck(ack, LORA_ACK_SIZE, &msg_id));
+
+    // a corrupt ACK isn't one
+    ack[4] = 0;
+    CHECK(LORA_CMD_NONE == commander.HandleAck(ack, LORA_ACK_SIZE, &msg_id));
+
+    // the unanswered command is resent until it runs out of tries
+    uint32_t now_ms = 0;
+    int attempts = 1;
+    for (;;) {
+        now_ms += LORA_CMD_RETRY_MS;
+        if (0 == commander.NextPacket(now_ms, packet)) break;
+        attempts++;
+    }
+    CHECK(LORA_CMD_TRIES == attempts);
+    CHECK(commander.TakeFailed(&msg_id) && 11 == msg_id);
+    CHECK(!commander.TakeFailed(&msg_id));
+    CHECK(LORA_CMD_TRIES + 1 == commander.Sent());
+    CHECK(1 == commander.Acked() && 1 == commander.Failed());
+
+    // a NAK fails the command at once
+    CHECK(commander.Queue(12, 0));
+    commander.NextPacket(now_ms, packet);
+    Ack(ack, packet[2], 12, 0);
+    CHECK(LORA_CMD_NAKED == commander.HandleAck(ack, LORA_ACK_SIZE, &msg_id) && 12 == msg_id);
+    CHECK(2 == commander.Failed());
+
+    // every slot taken by a different command
+    for (int i = 0; i < LORA_CMD_SLOTS; i++) CHECK(commander.Queue(20 + i, 0));
+    CHECK(!commander.Queue(30, 0));
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,51 @@
+/*
+ *  test_lora_link.cpp
+ *  Created: October 2026
+ *
+ *  LoRaLinkStats: the statistics and histograms, and the rate choice
+ *  stepping up one setting at a time and dropping as far as needed.
+ */
+
+#include "HostTest.h"
+#include "LoRaLink.h"
+
+// slowest first
+constexpr LoRaRate_t rates[] = {{9, 250000}, {8, 250000}, {7, 250000}, {7, 500000}};
+
+int main()
+{
+    LoRaLinkStats stats;
+
+    // too few packets to step up
+    for (int i = 0; i < 5; i++) stats.Note(-100, 5.0f, -300, true);
+    CHECK(0 == stats.ChooseRate(rates, 4, 0));
+
+    // SF8 floor is -10 dB, a 15 dB margin at 5 dB SNR: one step up only
+    for (int i = 0; i < 5; i++) stats.Note(-100, 5.0f, 200, true);
+    CHECK(1 == stats.ChooseRate(rates, 4, 0));
+
+    // measured at SF7/250 kHz, the 500 kHz setting keeps 9.5 dB
+    CHECK(3 == stats.ChooseRate(rates, 4, 2));
+
+    // a weak window at SF7/500 kHz drops straight to the slowest setting
+    stats.ResetWindow();
+    CHECK(0 == stats.WindowPackets());
+    for (int i = 0; i < 10; i++) stats.Note(-120, -8.0f, 0, true);
+    CHECK(0 == stats.ChooseRate(rates, 4, 3));
+
+    // packets outside the window still count in the statistics
+    stats.Note(-150, -30.0f, 0, false);
+    stats.Note(-20, 30.0f, 0, false);
+    CHECK(10 == stats.WindowPackets());
+    CHECK(22 == stats.Packets());
+    CHECK(300 == stats.MaxFreqError());
+    CHECK(-30.0f == stats.MinSNR());
+    CHECK(stats.RSSIHistogram()[0] >= 1 && 1 == stats.RSSIHistogram()[LORA_HIST_BINS - 1]);
+    CHECK(1 == stats.SNRHistogram()[LORA_HIST_BINS - 1]);
+
+    uint32_t total = 0;
+    for (int i = 0; i < LORA_HIST_BINS; i++) total += stats.SNRHistogram()[i];
+    CHECK(stats.Packets() == total);
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,63 @@
+/*
+ *  test_lora_queue.cpp
+ *  Created: October 2026
+ *
+ *  LoRaQueue: packets come out in order with their metadata through bursts
+ *  of producing and consuming, and full-queue and oversize drops are counted.
+ */
+
+#include "HostTest.h"
+#include "LoRaQueue.h"
+
+static LoRaPacket_t slots[LORA_QUEUE_DEPTH];
+
+int main()
+{
+    HostRandom random(36);
+    LoRaQueue queue;
+
+    // no slots yet
+    CHECK(NULL == queue.Reserve(5));
+
+    queue.AssignSlots(slots);
+    CHECK(NULL == queue.Front());
+
+    uint32_t next_in = 0;
+    uint32_t next_out = 0;
+    uint32_t refused = 0;
+    for (int round = 0; round < 2000; round++) {
+        uint32_t burst = random.Below(12);
+        for (uint32_t i = 0; i < burst; i++) {
+            LoRaPacket_t * packet = queue.Reserve(1 + (next_in % 200));
+            if (NULL == packet) {
+                refused++;
+                continue;
+            }
+            packet->data[0] = (uint8_t) next_in;
+            packet->rssi = (int16_t) next_in;
+            next_in++;
+            queue.Commit();
+        }
+
+        uint32_t drain = random.Below(12);
+        for (uint32_t i = 0; i < drain; i++) {
+            LoRaPacket_t * packet = queue.Front();
+            if (NULL == packet) break;
+            CHECK((int16_t) next_out == packet->rssi);
+            CHECK((uint8_t) next_out == packet->data[0]);
+            CHECK(1 + (next_out % 200) == packet->length);
+            next_out++;
+            queue.Pop();
+        }
+    }
+
+    CHECK(next_in == queue.Received());
+    CHECK(refused == queue.Dropped());
+    CHECK(LORA_QUEUE_DEPTH == queue.HighWater());
+
+    CHECK(NULL == queue.Reserve(LORA_MAX_PACKET + 1));
+    CHECK(NULL == queue.Reserve(-1));
+    CHECK(2 == queue.Overflows());
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,114 @@
+/*
+ *  test_lora_records.cpp
+ *  Created: October 2026
+ *
+ *  LoRaRecords: fragment checks, staging and flushing, duplicate and
+ *  missing fragments, the received ranges, and discards.
+ */
+
+#include "HostTest.h"
+#include "LoRaRecords.h"
+
+#define RECORD_BYTES 5
+
+static CRC32 crc;
+
+static uint16_t Fragment(uint8_t * packet, uint8_t profile, uint16_t seq, uint8_t records, bool last)
+{
+    uint16_t length = LORA_FRAG_HEADER_SIZE + records * RECORD_BYTES;
+
+    packet[0] = LORA_FRAG_MAGIC_0;
+    packet[1] = LORA_FRAG_MAGIC_1;
+    packet[2] = profile;
+    packet[3] = records | (last ? LORA_FRAG_LAST : 0);
+    packet[4] = (uint8_t) seq;
+    packet[5] = (uint8_t) (seq >> 8);
+    for (uint16_t i = LORA_FRAG_HEADER_SIZE; i < length; i++) packet[i] = (uint8_t) (seq * 7 + i);
+
+    uint32_t check = crc.Compute(packet + LORA_FRAG_HEADER_SIZE, length - LORA_FRAG_HEADER_SIZE);
+    for (int i = 0; i < 4; i++) packet[6 + i] = (uint8_t) (check >> (8 * i));
+
+    return length;
+}
+
+int main()
+{
+    LoRaRecords records(&crc, RECORD_BYTES);
+    uint8_t staging[80];
+    uint8_t packet[255];
+    uint16_t length = Fragment(packet, 3, 0, 4, false);
+
+    CHECK(FRAG_NO_BUFFER == records.Add(packet, length, 0));
+    records.AssignBuffer(staging, sizeof(staging));
+
+    // status JSON is not a fragment
+    CHECK(FRAG_NONE == records.Add((const uint8_t *) "{\"a\"", 4, 0));
+
+    CHECK(FRAG_ACCEPTED == records.Add(packet, length, 0));
+    CHECK(FRAG_DUPLICATE == records.Add(packet, length, 0));
+    packet[LORA_FRAG_HEADER_SIZE + 2] ^= 1;
+    CHECK(FRAG_BAD == records.Add(packet, length, 0));
+
+    // fragment 1 goes missing
+    length = Fragment(packet, 3, 2, 4, false);
+    CHECK(FRAG_ACCEPTED == records.Add(packet, length, 5));
+    CHECK(2 == records.Received() && 1 == records.Missing());
+
+    // flushed once the oldest has waited long enough
+    CHECK(!records.FlushDue(10, 60000));
+    CHECK(records.FlushDue(60000, 60000));
+
+    // staging full: send first, and a second try without sending discards
+    length = Fragment(packet, 3, 3, 4, false);
+    CHECK(FRAG_ACCEPTED == records.Add(packet, length, 5));
+    length = Fragment(packet, 3, 4, 4, false);
+    CHECK(FRAG_FLUSH_FIRST == records.Add(packet, length, 5));
+    CHECK(records.FlushDue(6, 60000));
+    CHECK(3 == records.StagedFragments() && 12 == records.StagedRecords());
+    CHECK(3 * (LORA_FRAG_ENTRY_SIZE + 4 * RECORD_BYTES) == records.StagedLength());
+    CHECK(FRAG_ACCEPTED == records.Add(packet, length, 5));
+    CHECK(3 == records.Discarded() && 1 == records.Received());
+    records.ClearStaged();
+
+    // the last fragment flushes at once
+    length = Fragment(packet, 3, 5, 4, true);
+    CHECK(FRAG_ACCEPTED == records.Add(packet, length, 7));
+    CHECK(records.FlushDue(7, 60000));
+    records.ClearStaged();
+
+    length = Fragment(packet, 3, 0, 4, false);
+    records.Add(packet, length, 8);
+    length = Fragment(packet, 3, 1, 4, false);
+    records.Add(packet, length, 8);
+    records.ClearStaged();
+
+    // received: 0-1 and 4-5
+    uint16_t ranges[8];
+    uint8_t count = 0;
+    uint16_t first = 0;
+    uint16_t last = 0;
+    while (count < 8 && records.NextRange(&first, &last)) {
+        ranges[count++] = first;
+        ranges[count++] = last;
+        first = last + 1;
+    }
+    CHECK(4 == count);
+    CHECK(0 == ranges[0] && 1 == ranges[1] && 4 == ranges[2] && 5 == ranges[3]);
+
+    // a new profile starts over
+    length = Fragment(packet, 4, 0, 4, false);
+    records.Add(packet, length, 9);
+    CHECK(4 == records.Profile() && 1 == records.Received());
+
+    // too big for the staging buffer
+    length = Fragment(packet, 4, 9, 40, false);
+    CHECK(FRAG_BAD == records.Add(packet, length, 9));
+
+    // losing the buffer discards what was staged and unmarks it
+    records.AssignBuffer(NULL, 0);
+    length = Fragment(packet, 4, 1, 4, false);
+    CHECK(FRAG_NO_BUFFER == records.Add(packet, length, 9));
+    CHECK(0 == records.Received());
+
+    return HOST_TEST_RESULT();
+}
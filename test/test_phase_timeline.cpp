@@ -0,0 +1,52 @@
+/*
+ *  test_phase_timeline.cpp
+ *  Created: October 2026
+ *
+ *  PhaseTimeline: only changes are kept, entries past the limit are counted,
+ *  and the formatted lines cover every entry.
+ */
+
+#include "HostTest.h"
+#include "PhaseTimeline.h"
+#include <string>
+
+int main()
+{
+    PhaseTimeline timeline;
+
+    // ignored outside a run
+    timeline.Note(TL_PROFILE, 1, 5);
+    CHECK(0 == timeline.Count());
+    CHECK(!timeline.Active());
+
+    timeline.Start(TL_PROFILE, 1000);
+    timeline.Note(TL_PROFILE, 1, 1000);
+    timeline.Note(TL_PROFILE, 1, 1010);
+    timeline.Note(TL_CHECK_PU, 0, 1020);
+    timeline.Note(TL_PROFILE, 2, 1030);
+    CHECK(3 == timeline.Count());
+    CHECK(TL_CHECK_PU == timeline.Entry(1).machine && 20 == timeline.Entry(1).offset_ms);
+
+    char line[32];
+    CHECK(3 == timeline.Format(0, line, sizeof(line)));
+    CHECK(std::string(line) == "PR.1@0 CK.0@20 PR.2@30");
+
+    for (int i = 0; i < 100; i++) timeline.Note(TL_OFFLOAD, (uint8_t) i, 2000 + i);
+    CHECK(PHASE_TIMELINE_ENTRIES == timeline.Count());
+    CHECK(3 + 100 - PHASE_TIMELINE_ENTRIES == timeline.Dropped());
+
+    CHECK(timeline.Finish(5000));
+    CHECK(!timeline.Finish(6000));
+    CHECK(4000 == timeline.ElapsedMs());
+
+    // short lines still make progress through every entry
+    uint8_t index = 0;
+    while (index < timeline.Count()) {
+        uint8_t next = timeline.Format(index, line, sizeof(line));
+        CHECK(next > index);
+        if (next <= index) break;
+        index = next;
+    }
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,165 @@
+/*
+ *  test_reed_solomon.cpp
+ *  Created: October 2026
+ *
+ *  ReedSolomon: clean codewords decode untouched, and up to nsym/2 symbol
+ *  errors are corrected, for every parity size and shortened lengths. Then
+ *  whole records in the LinkProtocol.h FEC layout: bursts of up to
+ *  depth * nsym/2 bytes across an interleaved group are corrected, and
+ *  longer ones either fail to decode or are caught by the record CRC-32.
+ */
+
+#include "HostTest.h"
+#include "ReedSolomon.h"
+#include "LinkProtocol.h"
+#include "CRC32.h"
+#include <vector>
+
+static ReedSolomon codec;
+static CRC32 crc;
+
+static void TestCodewords(HostRandom & random)
+{
+    for (int trial = 0; trial < 20000; trial++) {
+        uint8_t nsym = (uint8_t) (2 * (1 + random.Below(RS_MAX_PARITY / 2)));
+        uint16_t length = (uint16_t) (nsym + 1 + random.Below(RS_BLOCK_SIZE - nsym));
+        uint8_t codeword[RS_BLOCK_SIZE];
+        uint8_t original[RS_BLOCK_SIZE];
+
+        for (int i = 0; i < length - nsym; i++) codeword[i] = (uint8_t) random.Next();
+        codec.Encode(codeword, length - nsym, nsym, codeword + length - nsym);
+        memcpy(original, codeword, length);
+
+        CHECK(0 == codec.Decode(codeword, length, nsym));
+
+        // distinct positions, so the count corrected is exact
+        uint32_t errors = random.Below(nsym / 2 + 1);
+        bool hit[RS_BLOCK_SIZE] = {false};
+        for (uint32_t e = 0; e < errors; e++) {
+            uint32_t position;
+            do {
+                position = random.Below(length);
+            } while (hit[position]);
+            hit[position] = true;
+            codeword[position] ^= (uint8_t) (1 + random.Below(255));
+        }
+
+        CHECK((int) errors == codec.Decode(codeword, length, nsym));
+        CHECK(0 == memcmp(codeword, original, length));
+    }
+}
+
+// The coded part of an FEC record (no header): codewords of
+// FEC_CODEWORD_DATA(nsym) data symbols, the last zero-padded, interleaved in
+// groups of depth so that symbol j of codeword k goes to j * group + k
+static std::vector<uint8_t> EncodeRecord(const std::vector<uint8_t> & data, uint8_t nsym, uint8_t depth)
+{
+    uint16_t codeword_data = FEC_CODEWORD_DATA(nsym);
+    size_t codewords = (data.size() + codeword_data - 1) / codeword_data;
+    std::vector<uint8_t> coded(codewords * RS_BLOCK_SIZE);
+
+    for (size_t first = 0; first < codewords; first += depth) {
+        size_t group = (codewords - first < depth) ? codewords - first : depth;
+        for (size_t k = 0; k < group; k++) {
+            uint8_t codeword[RS_BLOCK_SIZE] = {};
+            size_t offset = (first + k) * codeword_data;
+            size_t count = (data.size() - offset < codeword_data) ? data.size() - offset : codeword_data;
+            memcpy(codeword, data.data() + offset, count);
+            codec.Encode(codeword, codeword_data, nsym, codeword + codeword_data);
+            for (size_t j = 0; j < RS_BLOCK_SIZE; j++) coded[first * RS_BLOCK_SIZE + j * group + k] = codeword[j];
+        }
+    }
+    return coded;
+}
+
+// The receive side as in StratoRachuts::DecodeFECRecord(); false if any
+// codeword was uncorrectable
+static bool DecodeRecord(const std::vector<uint8_t> & coded, uint8_t nsym, uint8_t depth, std::vector<uint8_t> & data)
+{
+    uint16_t codeword_data = FEC_CODEWORD_DATA(nsym);
+    size_t codewords = coded.size() / RS_BLOCK_SIZE;
+    size_t decoded = 0;
+    bool success = true;
+
+    for (size_t first = 0; first < codewords; first += depth) {
+        size_t group = (codewords - first < depth) ? codewords - first : depth;
+        for (size_t k = 0; k < group; k++) {
+            uint8_t codeword[RS_BLOCK_SIZE];
+            for (size_t j = 0; j < RS_BLOCK_SIZE; j++) codeword[j] = coded[first * RS_BLOCK_SIZE + j * group + k];
+            if (codec.Decode(codeword, RS_BLOCK_SIZE, nsym) < 0) success = false;
+
+            size_t count = (data.size() - decoded < codeword_data) ? data.size() - decoded : codeword_data;
+            memcpy(data.data() + decoded, codeword, count);
+            decoded += count;
+        }
+    }
+    return success;
+}
+
+static void Burst(HostRandom & random, std::vector<uint8_t> & coded, size_t start, size_t length)
+{
+    for (size_t i = start; i < start + length && i < coded.size(); i++) {
+        coded[i] ^= (uint8_t) (1 + random.Below(255));
+    }
+}
+
+static void TestInterleavedBursts(HostRandom & random)
+{
+    uint32_t beyond = 0;
+    uint32_t beyond_failed = 0;
+
+    for (int trial = 0; trial < 300; trial++) {
+        uint8_t nsym = (uint8_t) (2 * (1 + random.Below(RS_MAX_PARITY / 2)));
+        uint8_t depth = (uint8_t) (1 + random.Below(FEC_MAX_DEPTH));
+        std::vector<uint8_t> data(1 + random.Below(4096));
+        for (uint8_t & byte : data) byte = (uint8_t) random.Next();
+        uint32_t data_crc = crc.Compute(data.data(), data.size());
+
+        std::vector<uint8_t> coded = EncodeRecord(data, nsym, depth);
+        size_t codewords = coded.size() / RS_BLOCK_SIZE;
+
+        // One burst per interleaved group, each as long as the group can
+        // absorb. A burst inside a group of g codewords hits each codeword at
+        // most ceil(length / g) times.
+        std::vector<uint8_t> damaged = coded;
+        for (size_t first = 0; first < codewords; first += depth) {
+            size_t group = (codewords - first < depth) ? codewords - first : depth;
+            size_t length = group * (nsym / 2);
+            size_t start = first * RS_BLOCK_SIZE + random.Below((uint32_t) (group * RS_BLOCK_SIZE - length + 1));
+            Burst(random, damaged, start, length);
+        }
+
+        std::vector<uint8_t> received(data.size());
+        CHECK(DecodeRecord(damaged, nsym, depth, received));
+        CHECK(received == data);
+
+        // a longer burst somewhere in the record, straddling groups or not
+        size_t length = (size_t) depth * (nsym / 2) + 1 + random.Below((uint32_t) depth * RS_BLOCK_SIZE);
+        size_t start = random.Below((uint32_t) coded.size());
+        damaged = coded;
+        Burst(random, damaged, start, length);
+
+        // the codec may or may not notice; what it passes on as good must
+        // still be checked by the CRC-32
+        bool decoded = DecodeRecord(damaged, nsym, depth, received);
+        bool intact = (received == data);
+        CHECK(intact == (crc.Compute(received.data(), received.size()) == data_crc));
+        if (!intact) {
+            beyond++;
+            if (!decoded) beyond_failed++;
+        }
+    }
+
+    // most damaged records are flagged by the codec itself
+    CHECK(beyond > 0 && beyond_failed * 10 >= beyond * 9);
+}
+
+int main()
+{
+    HostRandom random(29);
+
+    TestCodewords(random);
+    TestInterleavedBursts(random);
+
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,139 @@
+/*
+ *  test_rpu_status.cpp
+ *  Created: October 2026
+ *
+ *  RPUStatus: parsing into typed fields, the named values, rejection of
+ *  malformed status text, and the versioned rendering.
+ */
+
+#include "HostTest.h"
+#include "RPUStatus.h"
+#include <string>
+
+static RPUStatus status;
+
+static std::string Rendered()
+{
+    char json[RPU_STATUS_JSON_SIZE];
+    if (!status.Render(json, sizeof(json))) return "";
+    return json;
+}
+
+static void TestEmpty()
+{
+    char json[16] = "x";
+    float value;
+
+    CHECK(!status.Valid() && !status.Pending());
+    CHECK(-1 == status.AgeSeconds(1000));
+    CHECK(!status.Value(RPU_BATTERY_TEMP, &value));
+    CHECK(!status.Render(json, sizeof(json)));
+}
+
+static void TestCapture()
+{
+    float value = 0;
+
+    CHECK(status.Capture(RPU_SRC_DOCK,
+                         " {\"TBat\": -12.5, \"VBat\":14.25,\"Records\":170,\"State\":\"PROF\\\"1\","
+                         "\"Heater\":true, \"Err\":null,\"GPS\":{\"lat\":1,\"s\":\"}\"},\"Arr\":[1,[2]]} ",
+                         5000, 1700000000));
+    CHECK(status.Valid() && status.Pending());
+    CHECK(RPU_SRC_DOCK == status.Source() && 0 == strcmp(status.SourceName(), "DOCK"));
+    CHECK(1700000000 == status.ReceivedEpoch());
+    CHECK(2 == status.AgeSeconds(7999));
+
+    CHECK(status.Value(RPU_BATTERY_TEMP, &value) && -12.5f == value);
+    CHECK(status.Value(RPU_BATTERY_VOLTS, &value) && 14.25f == value);
+    CHECK(status.Value(RPU_RECORDS, &value) && 170.0f == value);
+    // a string is not a number
+    CHECK(!status.Value(RPU_STATE, &value));
+
+    CHECK(6 == status.Fields() && 2 == status.Skipped());
+    CHECK(RPU_FIELD_TEXT == status.Field(3).kind && 0 == strcmp(status.Field(3).text, "PROF\"1"));
+    CHECK(RPU_FIELD_LITERAL == status.Field(4).kind);
+
+    CHECK(Rendered() == "{\"ver\":" + std::to_string(RPU_STATUS_VERSION)
+                        + ",\"TBat\":-12.5,\"VBat\":14.25,\"Records\":170,\"State\":\"PROF\\\"1\","
+                          "\"Heater\":true,\"Err\":null,\"skipped\":2}");
+
+    status.MarkReported();
+    CHECK(!status.Pending());
+}
+
+static void TestMalformed()
+{
+    const char * bad[] = {
+        "",
+        "[1,2]",
+        "{\"a\":1",
+        "{\"a\" 1}",
+        "{\"a\":1,}",
+        "{,}",
+        "{\"a\":tru}",
+        "{\"a\":nan}",
+        "{\"a\":1e999}",
+        "{\"a\":\"x}",
+        "{\"a\":\"\\q\"}",
+        "{\"a\":{\"b\":1}",
+        "{\"a\":1} x",
+    };
+
+    // each leaves the last good snapshot as it was
+    for (const char * json : bad) {
+        CHECK(!status.Capture(RPU_SRC_LORA, json, 9000, 0));
+        CHECK(RPU_SRC_DOCK == status.Source() && 6 == status.Fields());
+    }
+
+    CHECK(!status.Capture(RPU_SRC_NONE, "{}", 0, 0));
+    CHECK(!status.Capture(RPU_SRC_LORA, NULL, 0, 0));
+}
+
+static void TestReplace()
+{
+    float value;
+
+    // a later status replaces the whole table, values it lacks are absent
+    CHECK(status.Capture(RPU_SRC_LORA, "{\"State\":3,\"Records\":\"n/a\"}", 9000, 0));
+    CHECK(0 == strcmp(status.SourceName(), "LORA"));
+    CHECK(status.Value(RPU_STATE, &value) && 3.0f == value);
+    CHECK(!status.Value(RPU_RECORDS, &value));
+    CHECK(!status.Value(RPU_BATTERY_TEMP, &value));
+
+    CHECK(status.Capture(RPU_SRC_LORA, "{}", 9000, 0));
+    CHECK(0 == status.Fields() && 0 == status.Skipped());
+    CHECK(Rendered() == "{\"ver\":" + std::to_string(RPU_STATUS_VERSION) + "}");
+}
+
+static void TestLimits()
+{
+    // keys and strings too long to keep, and fields past the table, are skipped
+    std::string json = "{\"" + std::string(RPU_STATUS_KEY_SIZE, 'k') + "\":1,\"t\":\""
+                       + std::string(RPU_STATUS_TEXT_SIZE, 't') + "\",\"c\":\"\\u0007\\u00e9\"";
+    for (int i = 0; i < RPU_STATUS_MAX_FIELDS + 3; i++) json += ",\"f" + std::to_string(i) + "\":" + std::to_string(i);
+    json += "}";
+
+    CHECK(status.Capture(RPU_SRC_DOCK, json.c_str(), 0, 0));
+    CHECK(RPU_STATUS_MAX_FIELDS == status.Fields());
+    CHECK(2 + 4 == status.Skipped());
+    CHECK(0 == strcmp(status.Field(0).key, "c") && 0 == strcmp(status.Field(0).text, "\a?"));
+
+    // control characters are escaped again on the way out
+    std::string rendered = Rendered();
+    CHECK(rendered.find("\"c\":\"\\u0007?\"") != std::string::npos);
+
+    // a buffer too small for the block renders nothing
+    char small[32];
+    CHECK(!status.Render(small, sizeof(small)));
+    CHECK('\0' == small[0]);
+}
+
+int main()
+{
+    TestEmpty();
+    TestCapture();
+    TestMalformed();
+    TestReplace();
+    TestLimits();
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,260 @@
+/*
+ *  test_serial_framer.cpp
+ *  Created: October 2026
+ *
+ *  SerialFramer: frames split across polls, resync after garbage, sequence
+ *  tags, in-place BIN payloads, held frames, and link capture.
+ */
+
+#include "HostTest.h"
+#include "HostSerial.h"
+#include "SerialFramer.h"
+#include <string>
+#include <vector>
+
+static uint8_t frame_buffer[9000];
+
+static std::string Drain(SerialFramer & framer)
+{
+    std::string frame;
+    int c;
+    while ((c = framer.read()) >= 0) frame.push_back((char) c);
+    return frame;
+}
+
+// the checksum covers everything from the start character through the
+// terminator in front of it
+static std::string BinFrame(uint8_t id, const std::string & payload)
+{
+    std::string frame = "!" + std::to_string(id) + "," + std::to_string(payload.size()) + ";" + payload + ";";
+    uint8_t check_a = 0;
+    uint8_t check_b = 0;
+    for (char c : frame) {
+        check_a += (uint8_t) c;
+        check_b += check_a;
+    }
+    return frame + std::to_string(((uint16_t) check_a << 8) | check_b) + ";";
+}
+
+static void TestFrameTypes()
+{
+    HostSerial link;
+    SerialFramer framer(&link);
+    framer.AssignFrameBuffer(frame_buffer, sizeof(frame_buffer));
+
+    CHECK(!framer.Poll());
+
+    link.Feed("#12;345;?3,1;99;\"4,err text;777;");
+    CHECK(framer.Poll());
+    CHECK(Drain(framer) == "#12;345;");
+    CHECK(framer.Poll());
+    CHECK(Drain(framer) == "?3,1;99;");
+    CHECK(framer.Poll());
+    CHECK(Drain(framer) == "\"4,err text;777;");
+    CHECK(!framer.Poll());
+
+    // a BIN payload may hold any byte, including start characters and terminators
+    std::string bin = BinFrame(7, std::string("\x01#;!\x02\0", 6));
+    link.Feed(bin.substr(0, 7));
+    CHECK(!framer.Poll());
+    link.Feed(bin.substr(7));
+    CHECK(framer.Poll());
+
+    uint8_t id = 0;
+    uint8_t * payload = NULL;
+    uint16_t length = 0;
+    bool valid = false;
+    CHECK(framer.BinaryFrame(&id, &payload, &length, &valid));
+    CHECK(7 == id && 6 == length && valid);
+    CHECK(0 == memcmp(payload, "\x01#;!\x02\0", 6));
+    CHECK(Drain(framer) == bin);
+
+    // a corrupt payload is still framed, with the checksum flagged
+    bin = BinFrame(8, "abcdef");
+    bin[6] = 'X';
+    link.Feed(bin);
+    CHECK(framer.Poll());
+    CHECK(framer.BinaryFrame(&id, &payload, &length, &valid));
+    CHECK(8 == id && !valid);
+    Drain(framer);
+
+    // not a BIN frame
+    link.Feed("#1;2;");
+    CHECK(framer.Poll());
+    CHECK(!framer.BinaryFrame(&id, &payload, &length, &valid));
+
+    // writes go straight to the link
+    framer.write('x');
+    CHECK(link.tx == "x");
+}
+
+static void TestResync()
+{
+    HostSerial link;
+    SerialFramer framer(&link);
+    framer.AssignFrameBuffer(frame_buffer, sizeof(frame_buffer));
+
+    // leading garbage, and a real frame hidden inside a malformed one
+    link.Feed("junk{\"a\":1}#1x#5;9;");
+    CHECK(framer.Poll());
+    CHECK(Drain(framer) == "#5;9;");
+    CHECK(framer.DiscardedBytes() > 0);
+
+    // a declared length larger than the buffer can never complete
+    link.Feed("!1,9999;#8;8;");
+    CHECK(framer.Poll());
+    CHECK(Drain(framer) == "#8;8;");
+
+    // a long run of garbage without start characters, then a frame
+    std::string garbage;
+    for (int i = 0; i < 20000; i++) garbage.push_back("{k:12,v:abc}\r\n"[i % 14]);
+    link.Feed(garbage + "?9,0;1;");
+    CHECK(framer.Poll());
+    CHECK(Drain(framer) == "?9,0;1;");
+}
+
+// Valid frames separated by garbage that holds no start character must all
+// come through in order, however the bytes are split between polls
+static void TestRandomSplits()
+{
+    HostRandom random(26);
+    HostSerial link;
+    SerialFramer framer(&link);
+    framer.AssignFrameBuffer(frame_buffer, sizeof(frame_buffer));
+
+    std::vector<std::string> sent;
+    std::string stream;
+    for (int i = 0; i < 500; i++) {
+        uint32_t junk = random.Below(40);
+        for (uint32_t j = 0; j < junk; j++) stream.push_back("abc;,0123{}:\n"[random.Below(13)]);
+
+        std::string frame;
+        switch (random.Below(3)) {
+        case 0:
+            frame = "#" + std::to_string(random.Below(256)) + "," + std::to_string(random.Next()) + ";12;";
+            break;
+        case 1:
+            frame = "?" + std::to_string(random.Below(256)) + "," + std::to_string(random.Below(2)) + ";34;";
+            break;
+        default: {
+            std::string payload;
+            uint32_t payload_length = random.Below(2000);
+            for (uint32_t j = 0; j < payload_length; j++) payload.push_back((char) random.Next());
+            frame = BinFrame((uint8_t) random.Below(256), payload);
+            break;
+        }
+        }
+        sent.push_back(frame);
+        stream += frame;
+    }
+
+    std::vector<std::string> received;
+    size_t offset = 0;
+    while (offset < stream.size() || link.available()) {
+        size_t chunk = 1 + random.Below(700);
+        if (chunk > stream.size() - offset) chunk = stream.size() - offset;
+        link.Feed(stream.substr(offset, chunk));
+        offset += chunk;
+
+        while (framer.Poll()) {
+            uint8_t id;
+            uint8_t * payload;
+            uint16_t length;
+            bool valid = true;
+            framer.BinaryFrame(&id, &payload, &length, &valid);
+            CHECK(valid);
+            received.push_back(Drain(framer));
+        }
+    }
+
+    CHECK(received == sent);
+}
+
+static void TestTags()
+{
+    HostSerial link;
+    SerialFramer framer(&link);
+    framer.AssignFrameBuffer(frame_buffer, sizeof(frame_buffer));
+
+    framer.TX_Tag(7);
+    CHECK(link.tx.compare(0, 7, "#250,7;") == 0);
+
+    // the tag is consumed and attached to the frame after it only
+    uint8_t seq = 0;
+    link.Feed(link.tx + "?12,1;123;?12,1;123;");
+    CHECK(framer.Poll());
+    CHECK(framer.FrameTag(&seq) && 7 == seq);
+    CHECK(Drain(framer) == "?12,1;123;");
+    CHECK(framer.Poll());
+    CHECK(!framer.FrameTag(&seq));
+}
+
+static void TestHold()
+{
+    static uint8_t small_buffer[64];
+    HostSerial link;
+    SerialFramer framer(&link);
+    framer.AssignFrameBuffer(small_buffer, sizeof(small_buffer));
+
+    std::string first = BinFrame(1, "0123456789");
+    link.Feed(first);
+    CHECK(framer.Poll());
+    uint8_t id;
+    uint8_t * held_payload;
+    uint16_t length;
+    bool valid;
+    CHECK(framer.BinaryFrame(&id, &held_payload, &length, &valid));
+    framer.Hold();
+    CHECK(framer.HeldBytes() == first.size());
+
+    // later frames are assembled behind the held one, which stays intact
+    link.Feed("#2;2;");
+    CHECK(framer.Poll());
+    CHECK(Drain(framer) == "#2;2;");
+    CHECK(0 == memcmp(held_payload, "0123456789", 10));
+
+    // the next frame fits in the space the held one leaves
+    link.Feed(BinFrame(3, std::string(20, 'z')));
+    CHECK(framer.Poll());
+    CHECK(framer.BinaryFrame(&id, &held_payload, &length, &valid));
+    CHECK(3 == id && 20 == length && valid);
+    Drain(framer);
+
+    // once released, the whole buffer is free again
+    framer.ReleaseHeld();
+    link.Feed(BinFrame(4, std::string(40, 'y')));
+    CHECK(framer.Poll());
+    CHECK(0 == framer.HeldBytes());
+    CHECK(framer.BinaryFrame(&id, &held_payload, &length, &valid));
+    CHECK(4 == id && 40 == length && valid);
+}
+
+static void TestCapture()
+{
+    static uint8_t ring[256];
+    LinkCapture capture(ring, sizeof(ring));
+    HostSerial link;
+    SerialFramer framer(&link);
+    framer.AssignFrameBuffer(frame_buffer, sizeof(frame_buffer));
+    framer.SetCapture(&capture, CAPTURE_PU);
+
+    link.Feed("#1;2;");
+    CHECK(framer.Poll());
+    CHECK(capture.Bytes() == 5);
+
+    uint8_t record[CAPTURE_HEADER_SIZE + 5];
+    CHECK(capture.Read(0, record, sizeof(record)) == sizeof(record));
+    CHECK(CAPTURE_PU == record[0] && 5 == record[1]);
+    CHECK(0 == memcmp(record + CAPTURE_HEADER_SIZE, "#1;2;", 5));
+}
+
+int main()
+{
+    TestFrameTypes();
+    TestResync();
+    TestRandomSplits();
+    TestTags();
+    TestHold();
+    TestCapture();
+    return HOST_TEST_RESULT();
+}
@@ -0,0 +1,29 @@
+/*
+ *  test_text_catalog.cpp
+ *  Created: October 2026
+ *
+ *  TextCatalog: every ID has its message, and IDs outside the catalog have
+ *  none.
+ */
+
+#include "HostTest.h"
+#include "TextCatalog.h"
+#include <string>
+
+#define TEXT_CATALOG_COUNT(id, name, text) + 1
+#define TEXT_CATALOG_CHECK(id, name, text) CHECK(std::string(text) == TextCatalogString(name));
+
+int main()
+{
+    const int count = 0 TEXT_CATALOG(TEXT_CATALOG_COUNT);
+
+    CHECK(NULL == TextCatalogString(TXT_NONE));
+    CHECK(NULL == TextCatalogString((TextMsg_t) (count + 1)));
+
+    TEXT_CATALOG(TEXT_CATALOG_CHECK)
+
+    // IDs are dense from 1, so a gap means a renumbered or lost message
+    for (int id = 1; id <= count; id++) CHECK(NULL != TextCatalogString((TextMsg_t) id));
+
+    return HOST_TEST_RESULT();
+}
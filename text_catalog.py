@@ -0,0 +1,56 @@
+"""RACHUTSTEXT message catalog tool.
+
+Reads the catalog from src/TextCatalog.h.
+
+    python3 text_catalog.py expand < tm_log.txt    expand "#<id>" codes to text
+    python3 text_catalog.py inventory              markdown table of messages
+                                                   and where they are sent
+"""
+import glob
+import os
+import re
+import sys
+
+src_dir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "src")
+
+catalog_entry = re.compile(r'X\((\d+),\s*(\w+),\s*"((?:[^"\\]|\\.)*)"\)')
+send_site = re.compile(r'SendTextTM\((TXT_\w+),\s*(\w+)\)')
+code = re.compile(r'#(\d+)(?=$|[^\w ])')
+
+
+def read_catalog():
+    with open(os.path.join(src_dir, "TextCatalog.h")) as f:
+        return [(int(m.group(1)), m.group(2), m.group(3)) for m in catalog_entry.finditer(f.read())]
+
+
+def expand(catalog):
+    text = {id: message for id, name, message in catalog}
+    for line in sys.stdin:
+        line = line.rstrip("\n")
+        print(code.sub(lambda m: "#%s %s" % (m.group(1), text.get(int(m.group(1)), "?")), line))
+
+
+def inventory(catalog):
+    sites = {}
+    for path in sorted(glob.glob(os.path.join(src_dir, "*.cpp"))):
+        with open(path) as f:
+            for m in send_site.finditer(f.read()):
+                sites.setdefault(m.group(1), []).append("%s (%s)" % (os.path.basename(path), m.group(2)))
+
+    print("| ID | Message | Sent from (flag) |")
+    print("|---|---|---|")
+    for id, name, message in catalog:
+        used = ", ".join(sorted(set(sites.get(name, [])))) or "*(retired)*"
+        print("| %d | %s | %s |" % (id, message, used))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 2 or sys.argv[1] not in ("expand", "inventory"):
+        print(__doc__)
+        sys.exit(1)
+
+    catalog = read_catalog()
+    if sys.argv[1] == "expand":
+        expand(catalog)
+    else:
+        inventory(catalog)